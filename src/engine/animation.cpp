@@ -0,0 +1,147 @@
+#include "animation.h"
+
+#include "../io/profiler.h"
+
+/**
+ * AnimationSystem class
+ */
+
+void AnimationSystem::Configure(AnimationPlayback& playback, const Animation& animation) {
+
+    const uint32_t frameCount = static_cast<uint32_t>(animation.GetStepCount());
+
+    playback.frameCount = frameCount;
+    playback.secondsPerFrame = animation.GetFps() > 0 ? 1.0f / static_cast<float>(animation.GetFps()) : 0.0f;
+
+    if (frameCount < 2) {
+        playback.period = frameCount;
+    } else if (animation.GetType() == AnimationType::BACK_AND_FORTH) {
+        //0, 1, ..., n-1, n-2, ..., 1 und dann wieder 0: die Endframes werden nicht doppelt gezeigt
+        playback.period = 2 * (frameCount - 1);
+    } else {
+        playback.period = frameCount;
+    }
+
+    playback.phase = playback.period > 0 ? playback.phase % playback.period : 0;
+
+}
+
+AnimationInstance AnimationSystem::Create(AnimationHandle definition) {
+
+    const Animation *animation = AssetManager::ResolveAnimation(definition);
+    if (animation == nullptr) {
+        return {};
+    }
+
+    AnimationPlayback playback;
+    playback.definition = definition;
+    Configure(playback, *animation);
+
+    return playbacks.Insert(playback);
+
+}
+
+AnimationInstance AnimationSystem::GetShared(AnimationHandle definition) {
+
+    if (!definition.IsValid()) {
+        return {};
+    }
+
+    if (definition.index >= shared.size()) {
+        shared.resize(definition.index + 1);
+    }
+
+    //der Slot des Handles kann inzwischen einer anderen Animation gehören
+    AnimationInstance& instance = shared[definition.index];
+    const AnimationPlayback *playback = playbacks.Get(instance);
+    if (playback == nullptr || !(playback->definition == definition)) {
+        instance = Create(definition);
+    }
+
+    return instance;
+
+}
+
+void AnimationSystem::Destroy(AnimationInstance instance) {
+
+    playbacks.Erase(instance);
+
+}
+
+void AnimationSystem::Restart(AnimationInstance instance) {
+
+    if (AnimationPlayback *playback = playbacks.Get(instance)) {
+        playback->phase = 0;
+        playback->elapsed = 0;
+    }
+
+}
+
+void AnimationSystem::RefreshAfterReload() {
+
+    for (AnimationPlayback& playback : playbacks) {
+        if (const Animation *animation = AssetManager::ResolveAnimation(playback.definition)) {
+            Configure(playback, *animation);
+        }
+    }
+
+}
+
+void AnimationSystem::Advance(float deltaSeconds) {
+
+    PROFILE_ZONE("AnimationSystem::Advance");
+
+    const uint64_t generation = AssetManager::GetReloadGeneration();
+    if (generation != reloadGeneration) {
+        reloadGeneration = generation;
+        RefreshAfterReload();
+    }
+
+    for (AnimationPlayback& playback : playbacks) {
+
+        if (playback.period < 2 || playback.secondsPerFrame <= 0) {
+            continue;
+        }
+
+        playback.elapsed += deltaSeconds;
+        if (playback.elapsed < playback.secondsPerFrame) {
+            continue;
+        }
+
+        //auch bei einem großen Zeitschritt nur eine Division statt einer Schleife über alle übersprungenen Frames
+        const uint32_t steps = static_cast<uint32_t>(playback.elapsed / playback.secondsPerFrame);
+        playback.elapsed -= static_cast<float>(steps) * playback.secondsPerFrame;
+        playback.phase = static_cast<uint32_t>((static_cast<uint64_t>(playback.phase) + steps) % playback.period);
+
+    }
+
+}
+
+std::optional<AnimationFrame> AnimationSystem::GetFrame(AnimationInstance instance) const {
+
+    const AnimationPlayback *playback = playbacks.Get(instance);
+    if (playback == nullptr) {
+        return std::nullopt;
+    }
+
+    const Animation *animation = AssetManager::ResolveAnimation(playback->definition);
+    if (animation == nullptr || playback->frameCount == 0) {
+        return std::nullopt;
+    }
+
+    //im Rückwärtsteil des Zyklus von hinten zählen
+    uint32_t step = playback->phase < playback->frameCount ? playback->phase : playback->period - playback->phase;
+    //nach einem Hot Reload bis zum nächsten Advance() kann die Definition schon weniger Frames haben
+    if (step >= animation->GetStepCount()) {
+        step = 0;
+    }
+
+    return AnimationFrame{animation->GetAtlas(), animation->GetFrame(step)};
+
+}
+
+size_t AnimationSystem::GetInstanceCount() const {
+
+    return playbacks.Size();
+
+}
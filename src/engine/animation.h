@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include "assets.h"
+#include "slotmap.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Abspielzustand einer Animationsinstanz. Die Richtung beim Hin- und Herlaufen steckt in phase: die ersten frameCount Schritte laufen vorwärts,
+ * der Rest des Zyklus rückwärts.
+ */
+struct AnimationPlayback {
+    AnimationHandle definition;
+    float secondsPerFrame = 0;
+    //seit dem letzten Frameschritt vergangene Zeit
+    float elapsed = 0;
+    uint32_t phase = 0;
+    //Länge eines Zyklus in Schritten: LOOPING frameCount, BACK_AND_FORTH 2 * (frameCount - 1)
+    uint32_t period = 0;
+    uint32_t frameCount = 0;
+};
+
+using AnimationInstance = SlotHandle<AnimationPlayback>;
+
+/**
+ * Was für eine Animationsinstanz gerade gezeichnet werden muss.
+ */
+struct AnimationFrame {
+    Texture2D texture;
+    Rectangle source;
+};
+
+/**
+ * Spielt alle Animationen ab. Die Zustände liegen dicht in einem Array und werden einmal pro Tick in einem Durchlauf mit demselben Zeitschritt
+ * weitergezählt, statt dass jede Instanz selbst die Uhr abfragt. Instanzen aus GetShared() teilen sich einen Zustand und laufen dadurch
+ * synchron (z.B. alle Wasserkacheln).
+ *
+ * Nur auf dem Main-Thread benutzen.
+ */
+class AnimationSystem final {
+    public:
+        AnimationSystem() = default;
+        AnimationSystem(const AnimationSystem&) = delete;
+        AnimationSystem& operator=(const AnimationSystem&) = delete;
+        /**
+         * Legt eine eigene Instanz an, die beim ersten Frame beginnt. Gibt ein ungültiges Handle zurück, wenn die Animation nicht (mehr) geladen ist.
+         */
+        AnimationInstance Create(AnimationHandle definition);
+        /**
+         * Die gemeinsame Instanz dieser Animation; wird beim ersten Aufruf angelegt.
+         */
+        AnimationInstance GetShared(AnimationHandle definition);
+        void Destroy(AnimationInstance instance);
+        /**
+         * Setzt die Instanz auf den ersten Frame zurück.
+         */
+        void Restart(AnimationInstance instance);
+        /**
+         * Zählt alle Instanzen um deltaSeconds weiter. Einmal pro Tick aufrufen.
+         */
+        void Advance(float deltaSeconds);
+        /**
+         * Gibt std::nullopt zurück, wenn die Instanz zerstört oder ihre Animation entladen wurde.
+         */
+        std::optional<AnimationFrame> GetFrame(AnimationInstance instance) const;
+        size_t GetInstanceCount() const;
+    private:
+        /**
+         * Übernimmt fps und Frameanzahl aus der Definition. Der Zeitfortschritt bleibt erhalten, soweit er noch in den Zyklus passt.
+         */
+        static void Configure(AnimationPlayback& playback, const Animation& animation);
+        void RefreshAfterReload();
+        SlotMap<AnimationPlayback> playbacks;
+        //gemeinsame Instanzen nach Index des Animation-Handles
+        std::vector<AnimationInstance> shared;
+        uint64_t reloadGeneration = AssetManager::GetReloadGeneration();
+};
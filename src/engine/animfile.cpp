@@ -0,0 +1,322 @@
+#include "animfile.h"
+
+#include "assets.h"
+#include "atlas.h"
+
+#include "../io/debug.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+static constexpr char ANIMATION_MAGIC[4] = {'S', 'W', 'A', 'N'};
+static constexpr uint16_t ANIMATION_VERSION = 1;
+static constexpr size_t HEADER_SIZE = 24;
+static constexpr size_t FRAME_RECT_SIZE = 8;
+
+template<typename T>
+static T ReadLE(const unsigned char *p) {
+
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+
+}
+
+template<typename T>
+static void AppendLE(std::vector<unsigned char>& out, T value) {
+
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+
+}
+
+std::optional<AnimationData> ParseAnimationText(const std::string& source) {
+
+    Dictionary aniFileContent = ParseDictionary(source, "\n", "->");
+
+    std::vector<std::string> base64Textures(ANIMATION_MAX_FRAMES);
+    AnimationData data;
+
+    for (auto it = aniFileContent.begin(); it != aniFileContent.end(); ++it) {
+
+        const std::string& key = it->first;
+        const std::string& value = it->second;
+
+        if (IsPositiveInt(key)) {
+
+            const int index = std::stoi(key);
+            if (index >= static_cast<int>(ANIMATION_MAX_FRAMES)) {
+                Debug::Log<Debug::LogLevel::ERROR>("Could not parse .ani file: Frame index %i exceeds the maximum of %zu frames.", index, ANIMATION_MAX_FRAMES);
+                return std::nullopt;
+            }
+            base64Textures[index] = value;
+
+        } else if (key.compare("typ") == 0 || key.compare("type") == 0) {
+
+            if (value.compare("back/forth") == 0) {
+                data.type = AnimationType::BACK_AND_FORTH;
+            } else if (value.compare("looping") == 0) {
+                data.type = AnimationType::LOOPING;
+            } else {
+                Debug::Log<Debug::LogLevel::ERROR>("Could not parse .ani file: Unknown animation type '%s'.", value.c_str());
+                return std::nullopt;
+            }
+
+        } else if (key.compare("fps") == 0) {
+
+            data.fps = std::stoi(value);
+
+        } else if (key.compare("frames") == 0) {
+
+            data.frameLayout = ParsePositiveIntList(value, ",");
+
+        }
+
+    }
+
+    std::vector<Image> frameImages;
+
+    for (const std::string& encoded : base64Textures) {
+
+        if (encoded.empty()) continue;
+
+        static constexpr std::string_view prefix = "data:image/png;base64,";
+        const size_t start = encoded.starts_with(prefix) ? prefix.size() : 0;
+
+        const std::vector<unsigned char> decoded = Base64Decode(encoded.substr(start));
+        frameImages.push_back(LoadImageFromMemory(".png", decoded.data(), static_cast<int>(decoded.size())));
+
+    }
+
+    if (frameImages.empty()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not parse .ani file: No frames.");
+        return std::nullopt;
+    }
+
+    data.atlas = BuildAtlasImage(frameImages, &data.frames);
+
+    for (const Image& image : frameImages) {
+        UnloadImage(image);
+    }
+
+    for (const int index : data.frameLayout) {
+
+        if (index >= static_cast<int>(data.frames.size())) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not parse .ani file: Frame layout references missing frame %i.", index);
+            UnloadAnimationData(data);
+            return std::nullopt;
+        }
+
+    }
+
+    return data;
+
+}
+
+std::optional<AnimationData> ParseAnimationBinary(std::span<const unsigned char> bytes) {
+
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), ANIMATION_MAGIC, sizeof(ANIMATION_MAGIC)) != 0) {
+        Debug::Log<Debug::LogLevel::ERROR>("Not a compiled animation (.anib) file.");
+        return std::nullopt;
+    }
+
+    const unsigned char *p = bytes.data();
+    const uint16_t version = ReadLE<uint16_t>(p + 4);
+    const uint8_t type = p[6];
+    const uint8_t encoding = p[7];
+    const uint16_t fps = ReadLE<uint16_t>(p + 8);
+    const uint16_t frameCount = ReadLE<uint16_t>(p + 10);
+    const uint16_t layoutCount = ReadLE<uint16_t>(p + 12);
+    const uint16_t atlasWidth = ReadLE<uint16_t>(p + 14);
+    const uint16_t atlasHeight = ReadLE<uint16_t>(p + 16);
+    const uint32_t atlasBytes = ReadLE<uint32_t>(p + 20);
+
+    const size_t framesOffset = HEADER_SIZE;
+    const size_t layoutOffset = framesOffset + static_cast<size_t>(frameCount) * FRAME_RECT_SIZE;
+    const size_t atlasOffset = layoutOffset + static_cast<size_t>(layoutCount) * sizeof(uint16_t);
+
+    if (version != ANIMATION_VERSION || type > 1 || encoding > 1 || frameCount == 0 || atlasOffset + atlasBytes > bytes.size()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Compiled animation has version %i or a corrupt header.", version);
+        return std::nullopt;
+    }
+
+    AnimationData data;
+    data.fps = fps;
+    data.type = type == 0 ? AnimationType::LOOPING : AnimationType::BACK_AND_FORTH;
+
+    data.frames.reserve(frameCount);
+    for (size_t i = 0; i < frameCount; ++i) {
+
+        const unsigned char *rect = p + framesOffset + i * FRAME_RECT_SIZE;
+        data.frames.push_back({
+            static_cast<float>(ReadLE<uint16_t>(rect)),
+            static_cast<float>(ReadLE<uint16_t>(rect + 2)),
+            static_cast<float>(ReadLE<uint16_t>(rect + 4)),
+            static_cast<float>(ReadLE<uint16_t>(rect + 6))
+        });
+
+    }
+
+    data.frameLayout.reserve(layoutCount);
+    for (size_t i = 0; i < layoutCount; ++i) {
+
+        const uint16_t index = ReadLE<uint16_t>(p + layoutOffset + i * sizeof(uint16_t));
+        if (index >= frameCount) {
+            Debug::Log<Debug::LogLevel::ERROR>("Compiled animation references missing frame %i.", index);
+            return std::nullopt;
+        }
+        data.frameLayout.push_back(index);
+
+    }
+
+    const unsigned char *atlas = p + atlasOffset;
+
+    if (static_cast<AnimationAtlasEncoding>(encoding) == AnimationAtlasEncoding::RGBA8) {
+
+        const size_t expected = static_cast<size_t>(atlasWidth) * atlasHeight * 4;
+        if (atlasBytes != expected) {
+            Debug::Log<Debug::LogLevel::ERROR>("Compiled animation has %u atlas bytes, expected %zu.", atlasBytes, expected);
+            return std::nullopt;
+        }
+
+        void *pixels = MemAlloc(static_cast<unsigned int>(expected));
+        std::memcpy(pixels, atlas, expected);
+        data.atlas = Image{pixels, atlasWidth, atlasHeight, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+
+    } else {
+
+        data.atlas = LoadImageFromMemory(".png", atlas, static_cast<int>(atlasBytes));
+
+        if (data.atlas.data == nullptr || data.atlas.width != atlasWidth || data.atlas.height != atlasHeight) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not decode the atlas of a compiled animation.");
+            UnloadAnimationData(data);
+            return std::nullopt;
+        }
+
+    }
+
+    return data;
+
+}
+
+std::vector<unsigned char> WriteAnimationBinary(const AnimationData& data, AnimationAtlasEncoding encoding) {
+
+    std::vector<unsigned char> atlasBytes;
+
+    if (encoding == AnimationAtlasEncoding::RGBA8) {
+
+        Image rgba = ImageCopy(data.atlas);
+        ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        const unsigned char *pixels = static_cast<const unsigned char*>(rgba.data);
+        atlasBytes.assign(pixels, pixels + static_cast<size_t>(rgba.width) * rgba.height * 4);
+        UnloadImage(rgba);
+
+    } else {
+
+        int size = 0;
+        unsigned char *png = ExportImageToMemory(data.atlas, ".png", &size);
+        if (png == nullptr) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not encode animation atlas as PNG.");
+            return {};
+        }
+        atlasBytes.assign(png, png + size);
+        MemFree(png);
+
+    }
+
+    std::vector<unsigned char> out;
+    out.reserve(HEADER_SIZE + data.frames.size() * FRAME_RECT_SIZE + data.frameLayout.size() * sizeof(uint16_t) + atlasBytes.size());
+
+    out.insert(out.end(), ANIMATION_MAGIC, ANIMATION_MAGIC + sizeof(ANIMATION_MAGIC));
+    AppendLE<uint16_t>(out, ANIMATION_VERSION);
+    out.push_back(data.type == AnimationType::LOOPING ? 0 : 1);
+    out.push_back(static_cast<uint8_t>(encoding));
+    AppendLE<uint16_t>(out, static_cast<uint16_t>(data.fps));
+    AppendLE<uint16_t>(out, static_cast<uint16_t>(data.frames.size()));
+    AppendLE<uint16_t>(out, static_cast<uint16_t>(data.frameLayout.size()));
+    AppendLE<uint16_t>(out, static_cast<uint16_t>(data.atlas.width));
+    AppendLE<uint16_t>(out, static_cast<uint16_t>(data.atlas.height));
+    AppendLE<uint16_t>(out, 0);
+    AppendLE<uint32_t>(out, static_cast<uint32_t>(atlasBytes.size()));
+
+    for (const Rectangle& frame : data.frames) {
+        AppendLE<uint16_t>(out, static_cast<uint16_t>(frame.x));
+        AppendLE<uint16_t>(out, static_cast<uint16_t>(frame.y));
+        AppendLE<uint16_t>(out, static_cast<uint16_t>(frame.width));
+        AppendLE<uint16_t>(out, static_cast<uint16_t>(frame.height));
+    }
+
+    for (const int index : data.frameLayout) {
+        AppendLE<uint16_t>(out, static_cast<uint16_t>(index));
+    }
+
+    out.insert(out.end(), atlasBytes.begin(), atlasBytes.end());
+
+    return out;
+
+}
+
+Image BuildAtlasImage(const std::vector<Image>& frames, std::vector<Rectangle> *frameInfoOutput) {
+
+    static constexpr int PADDING = 1;
+
+    int maxWidth = 0;
+    int totalHeight = 0;
+    size_t area = 0;
+
+    for (const Image& frame : frames) {
+        maxWidth = std::max(maxWidth, frame.width + PADDING);
+        totalHeight += frame.height + PADDING;
+        area += static_cast<size_t>(frame.width + PADDING) * (frame.height + PADDING);
+    }
+
+    //ungefähr quadratisch: Breite ist die kleinste Zweierpotenz, deren Quadrat die Fläche aller Frames fasst. Die Höhe wird danach auf das Benutzte zugeschnitten.
+    int width = 1;
+    while (static_cast<size_t>(width) * width < area) {
+        width *= 2;
+    }
+    width = std::max(width, maxWidth);
+
+    //höchste Frames zuerst, das packt die Skyline am dichtesten
+    std::vector<size_t> order(frames.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&frames](size_t a, size_t b) {
+        return frames[a].height > frames[b].height;
+    });
+
+    //mit totalHeight als Höhe passt jeder Frame, notfalls alle untereinander
+    SkylinePacker packer(width, totalHeight);
+    std::vector<PackedRect> placements(frames.size());
+
+    for (const size_t index : order) {
+        placements[index] = packer.Insert(frames[index].width + PADDING, frames[index].height + PADDING).value();
+    }
+
+    Image atlas = GenImageColor(width, std::max(packer.GetUsedHeight(), 1), BLANK);
+
+    frameInfoOutput->clear();
+    frameInfoOutput->reserve(frames.size());
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+
+        BlitImage(atlas, frames[i], placements[i].x, placements[i].y);
+        frameInfoOutput->push_back({static_cast<float>(placements[i].x), static_cast<float>(placements[i].y), static_cast<float>(frames[i].width), static_cast<float>(frames[i].height)});
+
+    }
+
+    return atlas;
+
+}
+
+void UnloadAnimationData(AnimationData& data) {
+
+    if (data.atlas.data != nullptr) {
+        UnloadImage(data.atlas);
+        data.atlas = Image{};
+    }
+
+}
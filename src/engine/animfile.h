@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+enum class AnimationType {
+
+    LOOPING, BACK_AND_FORTH
+
+};
+
+inline constexpr size_t ANIMATION_MAX_FRAMES = 32;
+
+/**
+ * Dekodierter Inhalt einer .ani oder .anib Datei: ein fertig gepackter Atlas im Hauptspeicher, noch ohne GPU-Ressourcen.
+ * Kann auf dem Threadpool erzeugt werden; der Atlas muss mit UnloadAnimationData() oder nach dem Hochladen mit UnloadImage() freigegeben werden.
+ */
+struct AnimationData {
+    Image atlas{};
+    //Position jedes Frames im Atlas
+    std::vector<Rectangle> frames;
+    std::vector<int> frameLayout;
+    int fps = 0;
+    AnimationType type = AnimationType::LOOPING;
+};
+
+/**
+ * Wie der Atlas in einer .anib Datei gespeichert ist. RGBA8 lädt ohne jede Dekodierung, PNG ist auf der Platte deutlich kleiner.
+ */
+enum class AnimationAtlasEncoding : uint8_t {
+
+    RGBA8 = 0, PNG = 1
+
+};
+
+inline constexpr const char *ANIMATION_BINARY_EXTENSION = ".anib";
+
+/**
+ * Parst das Textformat (.ani): Zeilen "schlüssel->wert", Frames als base64 kodierte PNGs. Die Frames werden auf der CPU zu einem Atlas zusammengesetzt.
+ */
+std::optional<AnimationData> ParseAnimationText(const std::string& source);
+
+/**
+ * Parst das Binärformat (.anib). Es wird genau ein Bild dekodiert (bei RGBA8 nur kopiert), es gibt keinen Textparser und kein base64.
+ */
+std::optional<AnimationData> ParseAnimationBinary(std::span<const unsigned char> bytes);
+
+/**
+ * Serialisiert eine Animation ins Binärformat. Gibt einen leeren Vektor zurück, wenn der Atlas nicht kodiert werden konnte.
+ */
+std::vector<unsigned char> WriteAnimationBinary(const AnimationData& data, AnimationAtlasEncoding encoding);
+
+/**
+ * Packt die Frames mit dem SkylinePacker in ein möglichst quadratisches RGBA-Bild, Frames dürfen unterschiedlich groß sein. Läuft komplett auf der CPU, braucht also weder OpenGL-Kontext noch RenderTexture.
+ */
+Image BuildAtlasImage(const std::vector<Image>& frames, std::vector<Rectangle> *frameInfoOutput);
+
+void UnloadAnimationData(AnimationData& data);
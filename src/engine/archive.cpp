@@ -0,0 +1,204 @@
+#include "archive.h"
+
+#include "../io/debug.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+static constexpr char ARCHIVE_MAGIC[4] = {'S', 'W', 'P', 'K'};
+static constexpr size_t HEADER_SIZE = 16;
+static constexpr size_t INDEX_ENTRY_SIZE = 24;
+static constexpr uint64_t DATA_ALIGNMENT = 16;
+
+template<typename T>
+static T ReadLE(const unsigned char *p) {
+
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+
+}
+
+template<typename T>
+static void AppendLE(std::vector<unsigned char>& out, T value) {
+
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+
+}
+
+/**
+ * AssetArchive class
+ */
+
+AssetArchive *AssetArchive::Open(const std::string& path) {
+
+    AssetArchive *archive = new AssetArchive();
+    archive->path = path;
+
+    if (!archive->mapped.Open(path)) {
+        delete archive;
+        return nullptr;
+    }
+
+    const unsigned char *data = archive->mapped.Data();
+    const size_t size = archive->mapped.Size();
+
+    if (size < HEADER_SIZE || std::memcmp(data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+        Debug::Log<Debug::LogLevel::ERROR>("%s is not an asset archive.", path.c_str());
+        delete archive;
+        return nullptr;
+    }
+
+    const uint32_t version = ReadLE<uint32_t>(data + 4);
+    const uint32_t entryCount = ReadLE<uint32_t>(data + 8);
+    const uint32_t stringTableSize = ReadLE<uint32_t>(data + 12);
+
+    const size_t stringTableOffset = HEADER_SIZE + static_cast<size_t>(entryCount) * INDEX_ENTRY_SIZE;
+
+    if (version != VERSION || stringTableOffset + stringTableSize > size) {
+        Debug::Log<Debug::LogLevel::ERROR>("Asset archive %s has version %i or a corrupt index.", path.c_str(), version);
+        delete archive;
+        return nullptr;
+    }
+
+    const char *strings = reinterpret_cast<const char*>(data + stringTableOffset);
+    archive->entries.resize(entryCount);
+
+    for (uint32_t i = 0; i < entryCount; ++i) {
+
+        const unsigned char *p = data + HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        const uint32_t nameOffset = ReadLE<uint32_t>(p);
+        const uint32_t nameLength = ReadLE<uint32_t>(p + 4);
+        Entry& entry = archive->entries[i];
+        entry.offset = ReadLE<uint64_t>(p + 8);
+        entry.size = ReadLE<uint64_t>(p + 16);
+
+        if (static_cast<uint64_t>(nameOffset) + nameLength > stringTableSize || entry.offset + entry.size > size) {
+            Debug::Log<Debug::LogLevel::ERROR>("Asset archive %s has a corrupt index entry.", path.c_str());
+            delete archive;
+            return nullptr;
+        }
+
+        entry.name = std::string_view(strings + nameOffset, nameLength);
+
+    }
+
+    return archive;
+
+}
+
+std::optional<std::span<const unsigned char>> AssetArchive::Find(std::string_view name) const {
+
+    const auto it = std::lower_bound(entries.begin(), entries.end(), name, [](const Entry& entry, std::string_view n) {
+        return entry.name < n;
+    });
+
+    if (it == entries.end() || it->name != name) {
+        return std::nullopt;
+    }
+
+    return std::span<const unsigned char>(mapped.Data() + it->offset, it->size);
+
+}
+
+size_t AssetArchive::GetEntryCount() const {
+
+    return entries.size();
+
+}
+
+const std::string& AssetArchive::GetPath() const {
+
+    return path;
+
+}
+
+/**
+ * Free functions
+ */
+
+bool WriteAssetArchive(const std::string& sourceDir, const std::string& outputPath) {
+
+    namespace fs = std::filesystem;
+
+    if (!fs::is_directory(sourceDir)) {
+        Debug::Log<Debug::LogLevel::ERROR>("%s is not a directory.", sourceDir.c_str());
+        return false;
+    }
+
+    std::vector<std::pair<std::string, fs::path>> files;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(sourceDir)) {
+
+        if (entry.is_regular_file()) {
+            files.emplace_back(fs::relative(entry.path(), sourceDir).generic_string(), entry.path());
+        }
+
+    }
+
+    std::sort(files.begin(), files.end());
+
+    std::vector<unsigned char> stringTable;
+    for (const auto& [name, filePath] : files) {
+        stringTable.insert(stringTable.end(), name.begin(), name.end());
+    }
+
+    const uint64_t dataStart = HEADER_SIZE + files.size() * INDEX_ENTRY_SIZE + stringTable.size();
+
+    std::vector<unsigned char> header;
+    header.insert(header.end(), ARCHIVE_MAGIC, ARCHIVE_MAGIC + sizeof(ARCHIVE_MAGIC));
+    AppendLE<uint32_t>(header, AssetArchive::VERSION);
+    AppendLE<uint32_t>(header, static_cast<uint32_t>(files.size()));
+    AppendLE<uint32_t>(header, static_cast<uint32_t>(stringTable.size()));
+
+    std::vector<unsigned char> data;
+    uint32_t nameOffset = 0;
+    uint64_t offset = dataStart;
+
+    for (const auto& [name, filePath] : files) {
+
+        const uint64_t aligned = (offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+        data.resize(data.size() + (aligned - offset), 0);
+        offset = aligned;
+
+        std::ifstream in(filePath, std::ios::binary);
+        if (!in.is_open()) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not open %s for packing.", filePath.string().c_str());
+            return false;
+        }
+
+        const std::vector<unsigned char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        AppendLE<uint32_t>(header, nameOffset);
+        AppendLE<uint32_t>(header, static_cast<uint32_t>(name.size()));
+        AppendLE<uint64_t>(header, offset);
+        AppendLE<uint64_t>(header, content.size());
+
+        data.insert(data.end(), content.begin(), content.end());
+        nameOffset += static_cast<uint32_t>(name.size());
+        offset += content.size();
+
+    }
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open %s for writing.", outputPath.c_str());
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+    out.write(reinterpret_cast<const char*>(stringTable.data()), stringTable.size());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    if (!out.good()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not write asset archive %s.", outputPath.c_str());
+        return false;
+    }
+
+    Debug::Log("Packed %zu files from %s into %s.", files.size(), sourceDir.c_str(), outputPath.c_str());
+    return true;
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../io/mapped_file.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Gepacktes Asset-Archiv (.swpak), alle Zahlen little endian:
+ *
+ *  Header       magic "SWPK", u32 version, u32 entryCount, u32 stringTableSize
+ *  Index        entryCount Einträge, nach Name sortiert: u32 nameOffset, u32 nameLength, u64 dataOffset, u64 dataSize
+ *  Stringtabelle  alle Namen hintereinander (ohne Nullterminator), relativ zum gepackten Ordner mit '/' als Trenner
+ *  Daten        Inhalte der Dateien, jeweils auf 16 Byte ausgerichtet
+ *
+ * Das Archiv wird einmal komplett in den Speicher gemappt; Find() ist eine binäre Suche im Index und gibt direkt einen Ausschnitt des Mappings zurück.
+ */
+class AssetArchive final {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        /**
+         * Öffnet und mappt ein Archiv. Gibt nullptr zurück, wenn die Datei fehlt oder kein gültiges Archiv ist.
+         */
+        static AssetArchive *Open(const std::string& path);
+        ~AssetArchive() = default;
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive& operator=(const AssetArchive&) = delete;
+        /**
+         * Gibt den Inhalt eines Eintrags zurück. Der Speicher bleibt gültig, solange das Archiv existiert.
+         */
+        std::optional<std::span<const unsigned char>> Find(std::string_view name) const;
+        size_t GetEntryCount() const;
+        const std::string& GetPath() const;
+    private:
+        struct Entry {
+            std::string_view name;
+            uint64_t offset;
+            uint64_t size;
+        };
+        AssetArchive() = default;
+        std::string path;
+        MappedFile mapped;
+        std::vector<Entry> entries;
+};
+
+/**
+ * Packt alle Dateien in sourceDir (rekursiv) in ein Archiv. Wird vom swpak Tool benutzt.
+ */
+bool WriteAssetArchive(const std::string& sourceDir, const std::string& outputPath);
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "assetid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+
+struct AssetCacheStats {
+    size_t residentBytes = 0;
+    size_t budgetBytes = 0;
+    size_t entries = 0;
+    //Zugriffe, die einen geladenen Eintrag gefunden haben
+    uint64_t hits = 0;
+    //Einträge, die (neu) geladen werden mussten; ein Fehlschlag in einem Parent-Cache, den ein Kind dann findet, zählt nicht
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ * Speicher für geladene Assets einer Klasse (Texturen, Sounds, ...) mit Referenzzählung und einem Byte-Budget.
+ *
+ * Einträge werden auf drei Arten am Leben gehalten: durch Handles (Acquire()), durch Pinning (Pin(), für Aufrufer die den Rohwert behalten)
+ * oder solange das Budget reicht. Trim() verdrängt nicht referenzierte, nicht gepinnte Einträge in LRU-Reihenfolge, bis das Budget wieder passt.
+ * Trim() darf nur an Framegrenzen aufgerufen werden, damit kein Asset verschwindet, das im laufenden Frame noch gezeichnet wird.
+ *
+ * Backend entscheidet über Größe und Entladen eines Assets und muss folgendes anbieten:
+ *     size_t Bytes(const Resource&) const;
+ *     void Unload(Resource&);
+ * Damit lässt sich der Cache ohne GPU oder Audiogerät mit einem Fake-Backend testen.
+ *
+ * Nicht threadsicher, wird wie der AssetManager nur vom Main-Thread benutzt.
+ */
+template<typename Resource, typename Backend>
+class AssetCache final {
+    public:
+        /**
+         * Hält einen Eintrag fest, solange das Handle (oder eine Kopie davon) lebt. Überlebt ein Handle seinen Cache, ist es ungültig aber harmlos.
+         */
+        class Handle final {
+            public:
+                Handle() = default;
+                ~Handle() {
+                    Reset();
+                }
+                Handle(const Handle& other) : owner(other.owner), id(other.id) {
+                    Retain();
+                }
+                Handle& operator=(const Handle& other) {
+                    if (this != &other) {
+                        Reset();
+                        owner = other.owner;
+                        id = other.id;
+                        Retain();
+                    }
+                    return *this;
+                }
+                Handle(Handle&& other) noexcept : owner(std::move(other.owner)), id(std::exchange(other.id, AssetId{})) {}
+                Handle& operator=(Handle&& other) noexcept {
+                    if (this != &other) {
+                        Reset();
+                        owner = std::move(other.owner);
+                        id = std::exchange(other.id, AssetId{});
+                    }
+                    return *this;
+                }
+                bool IsValid() const {
+                    return owner != nullptr && *owner != nullptr;
+                }
+                AssetId GetId() const {
+                    return id;
+                }
+                /**
+                 * Der aktuelle Wert des Eintrags. Wird das Asset ersetzt (z.B. beim Hot Reload), sieht das Handle automatisch den neuen Wert.
+                 */
+                Resource Get() const {
+                    if (!IsValid()) {
+                        return Resource{};
+                    }
+                    return (*owner)->entries.Find(id)->resource;
+                }
+                void Reset() {
+                    if (IsValid()) {
+                        (*owner)->Release(id);
+                    }
+                    owner.reset();
+                    id = AssetId{};
+                }
+            private:
+                friend class AssetCache;
+                Handle(std::shared_ptr<AssetCache*> owner, AssetId id) : owner(std::move(owner)), id(id) {
+                    Retain();
+                }
+                void Retain() {
+                    if (IsValid()) {
+                        ++(*owner)->entries.Find(id)->references;
+                    }
+                }
+                std::shared_ptr<AssetCache*> owner;
+                AssetId id;
+        };
+
+        explicit AssetCache(size_t budgetBytes, Backend backend = {}) : backend(std::move(backend)) {
+            stats.budgetBytes = budgetBytes;
+        }
+        ~AssetCache() {
+            *self = nullptr;
+            entries.ForEach([this](AssetId, Entry& entry) {
+                backend.Unload(entry.resource);
+            });
+        }
+        AssetCache(const AssetCache&) = delete;
+        AssetCache& operator=(const AssetCache&) = delete;
+
+        /**
+         * Sucht einen Eintrag, zählt Treffer und markiert ihn als zuletzt benutzt.
+         */
+        const Resource *Find(AssetId id) {
+            Entry *entry = entries.Find(id);
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            ++stats.hits;
+            Touch(*entry);
+            return &entry->resource;
+        }
+        /**
+         * Wie Find(), aber ohne Statistik und ohne die LRU-Reihenfolge zu verändern.
+         */
+        const Resource *Peek(AssetId id) const {
+            const Entry *entry = entries.Find(id);
+            return entry != nullptr ? &entry->resource : nullptr;
+        }
+        /**
+         * Gibt ein Handle auf einen geladenen Eintrag zurück, oder ein ungültiges Handle wenn id nicht geladen ist.
+         * Zählt nicht als Treffer; normalerweise geht ein Find() voraus, das schon gezählt hat.
+         */
+        Handle Acquire(AssetId id) {
+            Entry *entry = entries.Find(id);
+            if (entry == nullptr) {
+                return Handle();
+            }
+            Touch(*entry);
+            return Handle(self, id);
+        }
+        /**
+         * Fügt einen Eintrag ein. Ein vorhandener Eintrag wird entladen und ersetzt; seine Handles und sein Pinning bleiben erhalten.
+         */
+        const Resource& Insert(AssetId id, Resource resource) {
+            Entry *entry = entries.Find(id);
+            if (entry != nullptr) {
+                stats.residentBytes -= entry->bytes;
+                backend.Unload(entry->resource);
+                entry->resource = std::move(resource);
+                Touch(*entry);
+            } else {
+                lru.push_back(id);
+                entry = &entries.Set(id, Entry{std::move(resource), 0, 0, false, std::prev(lru.end())});
+                ++stats.entries;
+                ++stats.misses;
+            }
+            entry->bytes = backend.Bytes(entry->resource);
+            stats.residentBytes += entry->bytes;
+            return entry->resource;
+        }
+        /**
+         * Verhindert das Verdrängen, bis Free() aufgerufen oder der Cache zerstört wird.
+         */
+        void Pin(AssetId id) {
+            if (Entry *entry = entries.Find(id)) {
+                entry->pinned = true;
+            }
+        }
+        /**
+         * Hebt das Pinning auf und entlädt den Eintrag sofort, falls kein Handle mehr existiert. Sonst wird er wie jeder freie Eintrag über das Budget verdrängt.
+         */
+        void Free(AssetId id) {
+            Entry *entry = entries.Find(id);
+            if (entry == nullptr) {
+                return;
+            }
+            entry->pinned = false;
+            if (entry->references == 0) {
+                Evict(id, *entry);
+            }
+        }
+        /**
+         * Verdrängt so lange die am längsten nicht benutzten freien Einträge, bis das Budget eingehalten wird. Gibt die Anzahl verdrängter Einträge zurück.
+         */
+        size_t Trim() {
+            size_t evicted = 0;
+            for (auto it = lru.begin(); it != lru.end() && stats.residentBytes > stats.budgetBytes;) {
+                Entry& entry = *entries.Find(*it++);
+                if (entry.references == 0 && !entry.pinned) {
+                    Evict(*entry.lruPosition, entry);
+                    ++stats.evictions;
+                    ++evicted;
+                }
+            }
+            return evicted;
+        }
+        void SetBudget(size_t budgetBytes) {
+            stats.budgetBytes = budgetBytes;
+        }
+        const AssetCacheStats& GetStats() const {
+            return stats;
+        }
+    private:
+        struct Entry {
+            Resource resource;
+            size_t bytes;
+            uint32_t references;
+            bool pinned;
+            typename std::list<AssetId>::iterator lruPosition;
+        };
+        void Touch(Entry& entry) {
+            lru.splice(lru.end(), lru, entry.lruPosition);
+        }
+        void Release(AssetId id) {
+            --entries.Find(id)->references;
+        }
+        void Evict(AssetId id, Entry& entry) {
+            stats.residentBytes -= entry.bytes;
+            --stats.entries;
+            backend.Unload(entry.resource);
+            lru.erase(entry.lruPosition);
+            entries.Erase(id);
+        }
+        AssetSlots<Entry> entries;
+        //vorne der am längsten nicht benutzte Eintrag
+        std::list<AssetId> lru;
+        AssetCacheStats stats;
+        Backend backend;
+        std::shared_ptr<AssetCache*> self{std::make_shared<AssetCache*>(this)};
+};
@@ -0,0 +1,84 @@
+#include "assetid.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace AssetIds {
+
+    struct IdentityHash {
+        size_t operator()(uint64_t hash) const {
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct InternTable {
+        std::shared_mutex mutex;
+        //deque, damit Referenzen aus GetName() beim Wachsen gültig bleiben
+        std::deque<std::string> names;
+        std::unordered_multimap<uint64_t, uint32_t, IdentityHash> byHash;
+    };
+
+    //als Funktion, damit auch während der statischen Initialisierung anderer Übersetzungseinheiten interniert werden kann
+    static InternTable& Table() {
+
+        static InternTable table;
+        return table;
+
+    }
+
+    AssetId Intern(std::string_view name, uint64_t hash) {
+
+        InternTable& table = Table();
+
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            const auto [begin, end] = table.byHash.equal_range(hash);
+            for (auto it = begin; it != end; ++it) {
+                if (table.names[it->second] == name) {
+                    return {it->second};
+                }
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+
+        //ein anderer Thread könnte den Namen in der Zwischenzeit eingetragen haben
+        const auto [begin, end] = table.byHash.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            if (table.names[it->second] == name) {
+                return {it->second};
+            }
+        }
+
+        const uint32_t index = static_cast<uint32_t>(table.names.size());
+        table.names.emplace_back(name);
+        table.byHash.emplace(hash, index);
+
+        return {index};
+
+    }
+
+    const std::string& GetName(AssetId id) {
+
+        static const std::string invalid = "<invalid asset id>";
+        InternTable& table = Table();
+
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        if (id.index >= table.names.size()) {
+            return invalid;
+        }
+        return table.names[id.index];
+
+    }
+
+    size_t GetCount() {
+
+        InternTable& table = Table();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names.size();
+
+    }
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * FNV-1a Hash eines Asset-Namens. constexpr, damit er für String-Literale schon beim Kompilieren feststeht.
+ */
+constexpr uint64_t HashAssetName(std::string_view name) {
+
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+
+}
+
+/**
+ * Kompaktes Handle auf einen internierten Asset-Namen. Der Index ist dicht vergeben und kann direkt als Arrayindex benutzt werden.
+ */
+struct AssetId {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    uint32_t index = INVALID_INDEX;
+
+    bool IsValid() const {
+        return index != INVALID_INDEX;
+    }
+    bool operator==(const AssetId& other) const = default;
+};
+
+/**
+ * Globale Interning-Tabelle für Asset-Namen. Gleiche Namen ergeben immer dieselbe AssetId. Threadsicher.
+ */
+namespace AssetIds {
+
+    /**
+     * Interniert einen Namen, dessen Hash schon bekannt ist (siehe ASSET_ID).
+     */
+    AssetId Intern(std::string_view name, uint64_t hash);
+
+    inline AssetId Intern(std::string_view name) {
+        return Intern(name, HashAssetName(name));
+    }
+
+    /**
+     * Gibt den Namen zu einer AssetId zurück. Die Referenz bleibt für die gesamte Laufzeit gültig.
+     */
+    const std::string& GetName(AssetId id);
+
+    size_t GetCount();
+
+}
+
+/**
+ * AssetId für ein String-Literal. Der Hash wird zur Compilezeit berechnet und interniert wird nur beim ersten Durchlaufen der Stelle,
+ * danach kostet der Ausdruck nur noch das Lesen einer statischen Variable.
+ */
+#define ASSET_ID(literal) ([]() -> AssetId { \
+        static const AssetId id = ::AssetIds::Intern(literal, std::integral_constant<uint64_t, ::HashAssetName(literal)>::value); \
+        return id; \
+    }())
+
+/**
+ * Dichte, über AssetId indizierte Tabelle. Ersetzt eine Hashmap von Namen auf Assets; ein Lookup ist ein einziger Arrayzugriff.
+ */
+template<typename T>
+class AssetSlots {
+    public:
+        T *Find(AssetId id) {
+            if (id.index >= slots.size() || !slots[id.index].has_value()) {
+                return nullptr;
+            }
+            return &slots[id.index].value();
+        }
+        const T *Find(AssetId id) const {
+            if (id.index >= slots.size() || !slots[id.index].has_value()) {
+                return nullptr;
+            }
+            return &slots[id.index].value();
+        }
+        bool Contains(AssetId id) const {
+            return Find(id) != nullptr;
+        }
+        T& Set(AssetId id, T value) {
+            if (id.index >= slots.size()) {
+                slots.resize(static_cast<size_t>(id.index) + 1);
+            }
+            slots[id.index] = std::move(value);
+            return slots[id.index].value();
+        }
+        void Erase(AssetId id) {
+            if (id.index < slots.size()) {
+                slots[id.index].reset();
+            }
+        }
+        void Clear() {
+            slots.clear();
+        }
+        /**
+         * Ruft f(AssetId, T&) für jeden belegten Slot auf.
+         */
+        template<typename F>
+        void ForEach(F f) {
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (slots[i].has_value()) {
+                    f(AssetId{static_cast<uint32_t>(i)}, slots[i].value());
+                }
+            }
+        }
+    private:
+        std::vector<std::optional<T>> slots;
+};
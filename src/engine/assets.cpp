@@ -1,252 +1,1359 @@
 #include "assets.h"
 
 #include "../io/debug.h"
+#include "../io/profiler.h"
 
+#include "threadpool.h"
+
+#include <algorithm>
 #include <filesystem>
+#include <string_view>
 #include <fstream>
 #include <sstream>
 #include <cctype>
+#include <deque>
+#include <mutex>
 
 /**
  * Animaton class
  */
 
-Animation::Animation(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type) 
-: atlas(spriteAtlas), frames(frames), frameLayout(frameLayout), type(type), timer(TickTimer(fps)) 
+Animation::Animation(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type)
+: atlas(spriteAtlas), frames(std::move(frames)), frameLayout(std::move(frameLayout)), fps(fps), type(type)
 {}
 
-/*
-TextureInfo Animation::TextureInfo() {
+void Animation::Free() {
+
+    UnloadTexture(atlas);
+
+}
+
+void Animation::Reload(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type) {
+
+    UnloadTexture(atlas);
+
+    atlas = spriteAtlas;
+    this->frames = std::move(frames);
+    this->frameLayout = std::move(frameLayout);
+    this->fps = fps;
+    this->type = type;
+
+}
+
+Texture2D Animation::GetAtlas() const {
+
+    return atlas;
+
+}
+
+Rectangle Animation::GetFrame(size_t step) const {
+
+    return frames[frameLayout[step]];
+
+}
+
+size_t Animation::GetStepCount() const {
+
+    return frameLayout.size();
+
+}
+
+int Animation::GetFps() const {
+
+    return fps;
+
+}
+
+AnimationType Animation::GetType() const {
+
+    return type;
+
+}
+
+/**
+ * AssetManager class
+ */
+
+struct MountedArchive {
+    std::string mountPoint;
+    std::unique_ptr<AssetArchive> archive;
+};
+
+//wird nur beim Start gemountet, danach nur noch gelesen
+static std::vector<MountedArchive> mountedArchives;
+
+bool AssetManager::MountArchive(const std::string& archivePath, const std::string& mountPoint) {
+
+    for (const MountedArchive& mounted : mountedArchives) {
+
+        if (mounted.archive->GetPath() == archivePath && mounted.mountPoint == mountPoint) {
+            return true;
+        }
+
+    }
+
+    AssetArchive *archive = AssetArchive::Open(archivePath);
+    if (archive == nullptr) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not mount asset archive %s.", archivePath.c_str());
+        return false;
+    }
+
+    Debug::Log("Mounted asset archive %s (%zu entries) at '%s'.", archivePath.c_str(), archive->GetEntryCount(), mountPoint.c_str());
+    mountedArchives.push_back({mountPoint, std::unique_ptr<AssetArchive>(archive)});
+
+    return true;
+
+}
+
+ArchiveLookup AssetManager::FindInArchives(const std::string& path) {
+
+    ArchiveLookup lookup{false, std::nullopt};
+
+    for (const MountedArchive& mounted : mountedArchives) {
+
+        if (!path.starts_with(mounted.mountPoint)) {
+            continue;
+        }
+
+        lookup.covered = true;
+        lookup.data = mounted.archive->Find(std::string_view(path).substr(mounted.mountPoint.size()));
+
+        if (lookup.data.has_value()) {
+            break;
+        }
+
+    }
+
+    return lookup;
+
+}
+
+/**
+ * Dekodiert ein Bild aus einem Archiv oder aus dem Dateisystem. Braucht keinen OpenGL-Kontext und darf deshalb auch auf dem Threadpool laufen.
+ */
+static std::optional<Image> DecodeImage(const std::string& path) {
+
+    const ArchiveLookup packed = AssetManager::FindInArchives(path);
+    Image image{};
+
+    if (packed.covered) {
+
+        if (!packed.data.has_value()) {
+            return std::nullopt;
+        }
+
+        image = LoadImageFromMemory(GetFileExtension(path.c_str()), packed.data->data(), static_cast<int>(packed.data->size()));
+
+    } else {
+
+        if (!std::filesystem::exists(path)) {
+            return std::nullopt;
+        }
+
+        image = LoadImage(path.c_str());
+
+    }
+
+    if (image.data == nullptr) {
+        return std::nullopt;
+    }
+
+    return image;
+
+}
+
+/**
+ * Liest eine Datei aus einem Archiv oder aus dem Dateisystem. Darf auf dem Threadpool laufen.
+ */
+static std::optional<std::string> ReadFileContents(const std::string& path) {
+
+    const ArchiveLookup packed = AssetManager::FindInArchives(path);
+
+    if (packed.covered) {
+
+        if (!packed.data.has_value()) {
+            return std::nullopt;
+        }
+
+        return std::string(reinterpret_cast<const char*>(packed.data->data()), packed.data->size());
+
+    }
+
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open file %s.", path.c_str());
+        return std::nullopt;
+    }
+    std::ostringstream out;
+
+    out << in.rdbuf();
+
+    return out.str();
+
+}
+
+/**
+ * Dekodiert eine Animation im Text- (.ani) oder Binärformat (.anib). Braucht keinen OpenGL-Kontext und darf auf dem Threadpool laufen.
+ */
+static std::optional<AnimationData> DecodeAnimation(const std::string& path) {
+
+    if (!path.ends_with(ANIMATION_BINARY_EXTENSION)) {
+
+        const std::optional<std::string> source = ReadFileContents(path);
+        if (!source.has_value()) {
+            return std::nullopt;
+        }
+        return ParseAnimationText(source.value());
+
+    }
+
+    //Binärdateien werden direkt aus dem Archiv bzw. dem gemappten File gelesen, ohne Zwischenkopie
+    const ArchiveLookup packed = AssetManager::FindInArchives(path);
+
+    if (packed.covered) {
+
+        if (!packed.data.has_value()) {
+            return std::nullopt;
+        }
+        return ParseAnimationBinary(packed.data.value());
+
+    }
+
+    MappedFile file;
+    if (!file.Open(path)) {
+        return std::nullopt;
+    }
+    return ParseAnimationBinary({file.Data(), file.Size()});
+
+}
+
+/**
+ * Lädt den Atlas einer dekodierten Animation hoch, ein einziger Upload. Nur auf dem Main-Thread.
+ */
+static Texture2D UploadAnimationAtlas(AnimationData& data) {
+
+    const Texture2D atlas = LoadTextureFromImage(data.atlas);
+    UnloadAnimationData(data);
+    return atlas;
+
+}
+
+/**
+ * Dekodiert einen Wave aus einem Archiv oder aus dem Dateisystem, siehe DecodeImage().
+ */
+static std::optional<Wave> DecodeWave(const std::string& path) {
+
+    const ArchiveLookup packed = AssetManager::FindInArchives(path);
+    Wave wave{};
+
+    if (packed.covered) {
+
+        if (!packed.data.has_value()) {
+            return std::nullopt;
+        }
+
+        wave = LoadWaveFromMemory(GetFileExtension(path.c_str()), packed.data->data(), static_cast<int>(packed.data->size()));
+
+    } else {
+
+        if (!std::filesystem::exists(path)) {
+            Debug::Log<Debug::LogLevel::DEBUG>("path does not exist: %s", path.c_str());
+            return std::nullopt;
+        }
+
+        wave = LoadWave(path.c_str());
+
+    }
+
+    if (wave.data == nullptr) {
+        return std::nullopt;
+    }
+
+    return wave;
+
+}
+
+size_t TextureCacheBackend::Bytes(const Texture2D& texture) const {
+
+    size_t bytes = static_cast<size_t>(GetPixelDataSize(texture.width, texture.height, texture.format));
+
+    //eine vollständige Mipmap-Kette kostet ungefähr ein Drittel zusätzlich
+    if (texture.mipmaps > 1) {
+        bytes += bytes / 3;
+    }
+
+    return bytes;
+
+}
+
+void TextureCacheBackend::Unload(Texture2D& texture) {
+
+    UnloadTexture(texture);
+
+}
+
+size_t SoundCacheBackend::Bytes(const Sound& sound) const {
+
+    return static_cast<size_t>(sound.frameCount) * sound.stream.channels * (sound.stream.sampleSize / 8);
+
+}
+
+void SoundCacheBackend::Unload(Sound& sound) {
+
+    UnloadSound(sound);
+
+}
+
+//alle lebenden AssetManager, damit ProcessUploads() an der Framegrenze ihre Caches trimmen kann. Als Funktion, weil AssetManager auch statisch angelegt werden.
+static std::vector<AssetManager*>& LiveManagers() {
+
+    static std::vector<AssetManager*> managers;
+    return managers;
+
+}
+
+AssetManager::AssetManager() : AssetManager(nullptr) {}
+
+//alle Animationen aller AssetManager in einem Container, damit ein Handle ohne Wissen über seinen AssetManager aufgelöst werden kann
+static SlotMap<Animation>& Animations() {
+
+    static SlotMap<Animation> animations;
+    return animations;
+
+}
+
+AssetManager::AssetManager(AssetManager *parent) {
+    this->parent = parent;
+    LiveManagers().push_back(this);
+    //schon hier anlegen, damit der Container statisch angelegte AssetManager überlebt
+    Animations();
+}
+
+AssetManager::~AssetManager() {
+
+    *self = nullptr;
+
+    std::erase(LiveManagers(), this);
+
+    loadedAnimations.ForEach([](AssetId, AnimationHandle& handle) {
+        if (Animation *animation = Animations().Get(handle)) {
+            animation->Free();
+        }
+        Animations().Erase(handle);
+    });
+
+}
+
+void AssetManager::AddSearchDir(std::string dir) {
+
+    if ((Debug::Config::WATCH_ASSET_DIRS || Debug::Config::HOT_RELOAD) && watcher == nullptr && FileWatcher::IsSupported()) {
+        watcher = std::make_unique<FileWatcher>();
+    }
+
+    SearchDir& searchDir = searchDirs.emplace_back();
+    searchDir.path = std::move(dir);
+    IndexSearchDir(searchDir);
+
+    //ein neuer Suchordner kann frühere Fehlschläge auflösen
+    resolvedPaths.Clear();
+
+}
+
+void AssetManager::IndexSearchDir(SearchDir& dir) {
+
+    PROFILE_ZONE("AssetManager::IndexSearchDir");
+
+    dir.files.clear();
+    dir.indexed = !FindInArchives(dir.path).covered;
+
+    if (!dir.indexed) {
+        return;
+    }
+
+    if (watcher != nullptr) {
+        watcher->Watch(dir.path);
+    }
+
+    //Identifier dürfen Unterordner enthalten ("music/funky.wav"), deshalb wird rekursiv indiziert
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator it(dir.path, error);
+
+    for (; !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+
+        if (it->is_directory(error)) {
+            if (watcher != nullptr) {
+                watcher->Watch(it->path().string());
+            }
+            continue;
+        }
+
+        dir.files.insert(it->path().lexically_relative(dir.path).generic_string());
+
+    }
+
+}
+
+void AssetManager::ProcessFileEvents() {
+
+    if (watcher == nullptr || !watcher->HasEvents()) {
+        return;
+    }
+
+    const std::vector<FileEvent> events = watcher->TakeEvents();
+
+    //geänderte Assets vor dem Verwerfen des Pfadcaches bestimmen, danach ist die Zuordnung Pfad -> AssetId weg
+    std::vector<AssetId> changed;
+    if (Debug::Config::HOT_RELOAD) {
+
+        resolvedPaths.ForEach([&](AssetId id, ResolvedPath& resolved) {
+
+            if (!resolved.found) {
+                return;
+            }
+
+            for (const FileEvent& event : events) {
+                if (event.path == resolved.path) {
+                    changed.push_back(id);
+                    return;
+                }
+            }
+
+        });
+
+    }
+
+    for (const FileEvent& event : events) {
+
+        std::string eventDir = event.dir;
+        if (!eventDir.empty() && eventDir.back() != '/') {
+            eventDir += '/';
+        }
+
+        for (SearchDir& dir : searchDirs) {
+            if (dir.indexed && eventDir.starts_with(dir.path)) {
+                IndexSearchDir(dir);
+            }
+        }
 
-    if (timer.ShouldTick()) {
-        if (type == AnimationType::LOOPING) {
+    }
+
+    resolvedPaths.Clear();
+
+    for (const AssetId id : changed) {
+        QueueReload(id);
+    }
+
+}
+
+bool AssetManager::CandidateExists(const std::string& path, const SearchDir *dir, const std::string& identifier) const {
+
+    const ArchiveLookup packed = FindInArchives(path);
+    if (packed.covered) {
+        return packed.data.has_value();
+    }
+
+    if (dir != nullptr && dir->indexed) {
+        return dir->files.contains(identifier);
+    }
+
+    return std::filesystem::exists(path);
+
+}
+
+std::optional<std::string> AssetManager::ResolvePath(AssetId id) {
+
+    ProcessFileEvents();
+
+    if (const ResolvedPath *cached = resolvedPaths.Find(id)) {
+
+        if (!cached->found) {
+            return std::nullopt;
+        }
+        return cached->path;
+
+    }
+
+    const std::string& identifier = AssetIds::GetName(id);
+    ResolvedPath& resolved = resolvedPaths.Set(id, {false, {}});
+
+    if (CandidateExists(identifier, nullptr, identifier)) {
+
+        resolved = {true, identifier};
+
+    } else {
+
+        for (const SearchDir& dir : searchDirs) {
+
+            std::string path = dir.path;
+            path += identifier;
+
+            if (CandidateExists(path, &dir, identifier)) {
+                resolved = {true, std::move(path)};
+                break;
+            }
+
+        }
+
+    }
+
+    if (!resolved.found) {
+        return std::nullopt;
+    }
+    return resolved.path;
+
+}
+
+std::vector<AssetManager::CandidateSource> AssetManager::CollectCandidates(AssetId id) {
+
+    std::vector<CandidateSource> candidates;
+
+    if (parent != nullptr) {
+        candidates = parent->CollectCandidates(id);
+    }
+
+    if (std::optional<std::string> path = ResolvePath(id)) {
+        candidates.push_back({self, {std::move(path.value())}});
+    }
+    return candidates;
+
+}
+
+TextureCache *AssetManager::FindLoadedTexture(AssetId id) {
+
+    if (parent != nullptr) {
+
+        if (TextureCache *parentRet = parent->FindLoadedTexture(id)) {
+            return parentRet;
+        }
+
+    }
+
+    if (loadedTextures.Find(id) != nullptr) {
+        return &loadedTextures;
+    }
+
+    return nullptr;
+
+}
+
+SoundCache *AssetManager::FindLoadedSound(AssetId id) {
+
+    if (parent != nullptr) {
+
+        if (SoundCache *parentRet = parent->FindLoadedSound(id)) {
+            return parentRet;
+        }
+
+    }
+
+    if (loadedSounds.Find(id) != nullptr) {
+        return &loadedSounds;
+    }
+
+    return nullptr;
+
+}
+
+TextureCache *AssetManager::_GetTexture(AssetId id) {
+
+    if (parent != nullptr) {
+
+        if (TextureCache *parentRet = parent->_GetTexture(id)) {
+            return parentRet;
+        }
+
+    }
+
+    if (loadedTextures.Find(id) != nullptr) {
+        return &loadedTextures;
+    }
+
+    //läuft schon im Hintergrund: nicht doppelt laden, sondern auf das Ergebnis warten
+    if (const TextureRequest *pending = pendingTextures.Find(id)) {
+        const TextureRequest request = *pending;
+        request.Wait();
+        return FindLoadedTexture(id);
+    }
+
+    const std::optional<std::string> path = ResolvePath(id);
+    if (!path.has_value()) {
+        return nullptr;
+    }
+
+    PROFILE_ZONE("AssetManager::LoadTexture");
+
+    const std::optional<Image> image = DecodeImage(path.value());
+
+    if (!image.has_value()) {
+        return nullptr;
+    }
+
+    loadedTextures.Insert(id, LoadTextureFromImage(image.value()));
+    UnloadImage(image.value());
+    return &loadedTextures;
+
+}
+
+std::optional<Texture2D> AssetManager::GetTexture(AssetId id) {
+
+    TextureCache *cache = _GetTexture(id);
+
+    if (cache == nullptr) {
+
+        if (Debug::Config::LOG_MISSING_ASSETS) {
+            Debug::Log<Debug::LogLevel::WARNING>("Missing texture: %s", AssetIds::GetName(id).c_str());
+        }
+        return std::nullopt;
+
+    }
+
+    cache->Pin(id);
+    return *cache->Peek(id);
+
+}
+
+std::optional<Texture2D> AssetManager::GetTexture(const std::string& identifier) {
+    return GetTexture(AssetIds::Intern(identifier));
+}
+
+std::optional<TextureHandle> AssetManager::AcquireTexture(AssetId id) {
+
+    TextureCache *cache = _GetTexture(id);
+
+    if (cache == nullptr) {
+
+        if (Debug::Config::LOG_MISSING_ASSETS) {
+            Debug::Log<Debug::LogLevel::WARNING>("Missing texture: %s", AssetIds::GetName(id).c_str());
+        }
+        return std::nullopt;
+
+    }
+
+    return cache->Acquire(id);
+
+}
+
+std::optional<TextureHandle> AssetManager::AcquireTexture(const std::string& identifier) {
+    return AcquireTexture(AssetIds::Intern(identifier));
+}
+
+void AssetManager::SetTextureBudget(size_t bytes) {
+    loadedTextures.SetBudget(bytes);
+}
+
+const AssetCacheStats& AssetManager::GetTextureStats() const {
+    return loadedTextures.GetStats();
+}
+
+SoundCache *AssetManager::_GetSound(AssetId id) {
+
+    if (parent != nullptr) {
+
+        if (SoundCache *parentRet = parent->_GetSound(id)) {
+            return parentRet;
+        }
+
+    }
+
+    if (loadedSounds.Find(id) != nullptr) {
+        return &loadedSounds;
+    }
+
+    if (const SoundRequest *pending = pendingSounds.Find(id)) {
+        const SoundRequest request = *pending;
+        request.Wait();
+        return FindLoadedSound(id);
+    }
+
+    const std::optional<std::string> path = ResolvePath(id);
+    if (!path.has_value()) {
+        return nullptr;
+    }
+
+    PROFILE_ZONE("AssetManager::LoadSound");
+
+    const std::optional<Wave> wave = DecodeWave(path.value());
+
+    if (!wave.has_value()) {
+        return nullptr;
+    }
+
+    const Sound sound = LoadSoundFromWave(wave.value());
+    UnloadWave(wave.value());
+
+    if (sound.stream.buffer == nullptr) {
+        return nullptr;
+    }
+
+    loadedSounds.Insert(id, sound);
+    return &loadedSounds;
+
+}
+
+std::optional<Sound> AssetManager::GetSound(AssetId id) {
+
+    SoundCache *cache = _GetSound(id);
+
+    if (cache == nullptr) {
+
+        if (Debug::Config::LOG_MISSING_ASSETS) {
+            Debug::Log<Debug::LogLevel::WARNING>("Missing sound: %s", AssetIds::GetName(id).c_str());
+        }
+        return std::nullopt;
+
+    }
+
+    cache->Pin(id);
+    return *cache->Peek(id);
+
+}
+
+std::optional<Sound> AssetManager::GetSound(const std::string& identifier) {
+    return GetSound(AssetIds::Intern(identifier));
+}
+
+std::shared_ptr<MusicStream> AssetManager::OpenMusicStream(AssetId id) {
+
+    if (parent != nullptr) {
+        if (std::shared_ptr<MusicStream> stream = parent->OpenMusicStream(id)) {
+            return stream;
+        }
+    }
+
+    const std::optional<std::string> path = ResolvePath(id);
+    if (!path.has_value()) {
+        return nullptr;
+    }
+
+    //aus dem Archiv wird direkt im gemappten Eintrag gelesen, lose Dateien mappt der Stream selbst
+    const ArchiveLookup packed = FindInArchives(path.value());
+    std::unique_ptr<WavStream> source;
+
+    if (packed.covered) {
+        if (packed.data.has_value()) {
+            source = WavStream::OpenMemory(packed.data.value(), path.value());
+        }
+    } else {
+        source = WavStream::OpenFile(path.value());
+    }
+
+    if (source == nullptr) {
+        return nullptr;
+    }
+
+    return std::make_shared<MusicStream>(std::move(source));
+
+}
+
+std::shared_ptr<MusicStream> AssetManager::OpenMusicStream(const std::string& identifier) {
+
+    const AssetId id = AssetIds::Intern(identifier);
+    std::shared_ptr<MusicStream> stream = OpenMusicStream(id);
+
+    if (stream == nullptr && Debug::Config::LOG_MISSING_ASSETS) {
+        Debug::Log<Debug::LogLevel::WARNING>("Missing music: %s", identifier.c_str());
+    }
+
+    return stream;
+
+}
+
+std::optional<SoundHandle> AssetManager::AcquireSound(AssetId id) {
+
+    SoundCache *cache = _GetSound(id);
+
+    if (cache == nullptr) {
+
+        if (Debug::Config::LOG_MISSING_ASSETS) {
+            Debug::Log<Debug::LogLevel::WARNING>("Missing sound: %s", AssetIds::GetName(id).c_str());
+        }
+        return std::nullopt;
+
+    }
+
+    return cache->Acquire(id);
+
+}
+
+std::optional<SoundHandle> AssetManager::AcquireSound(const std::string& identifier) {
+    return AcquireSound(AssetIds::Intern(identifier));
+}
+
+void AssetManager::SetSoundBudget(size_t bytes) {
+    loadedSounds.SetBudget(bytes);
+}
+
+const AssetCacheStats& AssetManager::GetSoundStats() const {
+    return loadedSounds.GetStats();
+}
+
+/**
+ * Asynchrones Laden
+ */
+
+struct PendingUpload {
+    AssetId id;
+    //der AssetManager, der angefragt hat, und der, in dessen Suchpfaden das Asset gefunden wurde (kann ein Parent sein)
+    std::shared_ptr<AssetManager*> requester;
+    std::shared_ptr<AssetManager*> owner;
+    std::optional<Image> image;
+    std::optional<Wave> wave;
+    std::shared_ptr<AssetRequestData<Texture2D>> textureRequest;
+    std::shared_ptr<AssetRequestData<Sound>> soundRequest;
+    //Hot Reload: ersetzt ein schon geladenes Asset, statt ein Request fertigzumachen
+    bool reload = false;
+    std::optional<AnimationData> animation;
+    //nur für RequestAtlasSprite(): der Atlas, in den das Bild gepackt wird
+    std::shared_ptr<AssetRequestData<AtlasSprite>> spriteRequest;
+    std::shared_ptr<TextureAtlas*> atlas;
+};
+
+static uint64_t reloadGeneration = 0;
+
+static std::mutex uploadMutex;
+static std::deque<PendingUpload> uploadQueue;
+
+static ThreadPool& AssetThreadPool() {
+
+    static ThreadPool pool;
+    return pool;
+
+}
+
+static void QueueUpload(PendingUpload&& upload) {
+
+    std::lock_guard<std::mutex> lock(uploadMutex);
+    uploadQueue.push_back(std::move(upload));
+
+}
+
+TextureRequest AssetManager::RequestTexture(const std::string& identifier) {
+    return RequestTexture(AssetIds::Intern(identifier));
+}
+
+TextureRequest AssetManager::RequestTexture(AssetId id) {
+
+    if (TextureCache *cache = FindLoadedTexture(id)) {
+
+        auto data = std::make_shared<AssetRequestData<Texture2D>>();
+        data->asset = *cache->Peek(id);
+        data->hold = std::make_shared<TextureHandle>(cache->Acquire(id));
+        data->state.store(AssetRequestState::READY, std::memory_order_release);
+        return TextureRequest(data);
+
+    }
+
+    if (const TextureRequest *pending = pendingTextures.Find(id)) {
+        return *pending;
+    }
+
+    auto data = std::make_shared<AssetRequestData<Texture2D>>();
+    const TextureRequest request = pendingTextures.Set(id, TextureRequest(data));
+
+    //mutable: data wandert in den Upload, damit die letzte Referenz und mit ihr das Cache-Handle nie auf dem Worker stirbt
+    AssetThreadPool().Submit([id, data, requester = self, candidates = CollectCandidates(id)]() mutable {
+
+        PROFILE_ZONE("AssetManager::DecodeTexture");
+
+        PendingUpload upload{id, requester, nullptr, std::nullopt, std::nullopt, std::move(data), nullptr, false, std::nullopt, nullptr, nullptr};
+
+        for (const CandidateSource& source : candidates) {
+            for (const std::string& path : source.paths) {
+
+                upload.image = DecodeImage(path);
+                if (upload.image.has_value()) {
+                    upload.owner = source.owner;
+                    QueueUpload(std::move(upload));
+                    return;
+                }
+
+            }
+        }
+
+        QueueUpload(std::move(upload));
+
+    });
+
+    return request;
+
+}
+
+SoundRequest AssetManager::RequestSound(const std::string& identifier) {
+    return RequestSound(AssetIds::Intern(identifier));
+}
+
+SoundRequest AssetManager::RequestSound(AssetId id) {
+
+    if (SoundCache *cache = FindLoadedSound(id)) {
+
+        auto data = std::make_shared<AssetRequestData<Sound>>();
+        data->asset = *cache->Peek(id);
+        data->hold = std::make_shared<SoundHandle>(cache->Acquire(id));
+        data->state.store(AssetRequestState::READY, std::memory_order_release);
+        return SoundRequest(data);
+
+    }
+
+    if (const SoundRequest *pending = pendingSounds.Find(id)) {
+        return *pending;
+    }
+
+    auto data = std::make_shared<AssetRequestData<Sound>>();
+    const SoundRequest request = pendingSounds.Set(id, SoundRequest(data));
+
+    //mutable: data wandert in den Upload, damit die letzte Referenz und mit ihr das Cache-Handle nie auf dem Worker stirbt
+    AssetThreadPool().Submit([id, data, requester = self, candidates = CollectCandidates(id)]() mutable {
+
+        PROFILE_ZONE("AssetManager::DecodeSound");
+
+        PendingUpload upload{id, requester, nullptr, std::nullopt, std::nullopt, nullptr, std::move(data), false, std::nullopt, nullptr, nullptr};
+
+        for (const CandidateSource& source : candidates) {
+            for (const std::string& path : source.paths) {
+
+                upload.wave = DecodeWave(path);
+                if (upload.wave.has_value()) {
+                    upload.owner = source.owner;
+                    QueueUpload(std::move(upload));
+                    return;
+                }
+
+            }
+        }
+
+        QueueUpload(std::move(upload));
+
+    });
+
+    return request;
+
+}
+
+void AssetManager::SetAtlas(TextureAtlas *atlas) {
+
+    this->atlas = atlas;
+
+}
+
+TextureAtlas *AssetManager::GetAtlas() {
+
+    if (atlas == nullptr && parent != nullptr) {
+        return parent->GetAtlas();
+    }
+
+    return atlas;
+
+}
+
+AtlasSpriteRequest AssetManager::RequestAtlasSprite(const std::string& identifier) {
+    return RequestAtlasSprite(AssetIds::Intern(identifier));
+}
+
+AtlasSpriteRequest AssetManager::RequestAtlasSprite(AssetId id) {
+
+    TextureAtlas *target = GetAtlas();
+    auto data = std::make_shared<AssetRequestData<AtlasSprite>>();
+
+    if (target == nullptr) {
+
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot load %s into an atlas: no atlas set for this AssetManager.", AssetIds::GetName(id).c_str());
+        data->state.store(AssetRequestState::FAILED, std::memory_order_release);
+        return AtlasSpriteRequest(data);
+
+    }
+
+    if (const std::optional<AtlasSprite> sprite = target->Find(id)) {
+
+        data->asset = sprite.value();
+        data->state.store(AssetRequestState::READY, std::memory_order_release);
+        return AtlasSpriteRequest(data);
+
+    }
+
+    if (const AtlasSpriteRequest *pending = pendingSprites.Find(id)) {
+        return *pending;
+    }
+
+    const AtlasSpriteRequest request = pendingSprites.Set(id, AtlasSpriteRequest(data));
+
+    AssetThreadPool().Submit([id, data, requester = self, atlas = target->GetSelf(), candidates = CollectCandidates(id)]() {
+
+        PROFILE_ZONE("AssetManager::DecodeAtlasSprite");
+
+        PendingUpload upload{id, requester, nullptr, std::nullopt, std::nullopt, nullptr, nullptr, false, std::nullopt, data, atlas};
+
+        for (const CandidateSource& source : candidates) {
+            for (const std::string& path : source.paths) {
+
+                upload.image = DecodeImage(path);
+                if (upload.image.has_value()) {
+                    upload.owner = source.owner;
+                    QueueUpload(std::move(upload));
+                    return;
+                }
+
+            }
+        }
+
+        QueueUpload(std::move(upload));
+
+    });
+
+    return request;
+
+}
+
+void AssetManager::QueueReload(AssetId id) {
+
+    TextureAtlas *spriteAtlas = GetAtlas();
+
+    const bool texture = loadedTextures.Peek(id) != nullptr || (spriteAtlas != nullptr && spriteAtlas->Contains(id));
+    const bool sound = loadedSounds.Peek(id) != nullptr;
+    const bool animation = loadedAnimations.Contains(id);
+
+    const std::optional<std::string> path = ResolvePath(id);
+
+    if (!path.has_value() || !(texture || sound || animation)) {
+        return;
+    }
+
+    Debug::Log("Hot reloading %s.", path->c_str());
+
+    AssetThreadPool().Submit([id, texture, sound, path = path.value(), requester = self]() {
+
+        PROFILE_ZONE("AssetManager::DecodeReload");
+
+        PendingUpload upload{id, requester, requester, std::nullopt, std::nullopt, nullptr, nullptr, true, std::nullopt, nullptr, nullptr};
+
+        if (texture) {
+            upload.image = DecodeImage(path);
+        } else if (sound) {
+            upload.wave = DecodeWave(path);
+        } else {
+            upload.animation = DecodeAnimation(path);
+        }
+
+        QueueUpload(std::move(upload));
+
+    });
+
+}
+
+void AssetManager::ApplyReload(PendingUpload& upload) {
+
+    PROFILE_ZONE("AssetManager::ApplyReload");
+
+    const std::string& name = AssetIds::GetName(upload.id);
+
+    if (upload.image.has_value()) {
+
+        const Image& image = upload.image.value();
+
+        if (const Texture2D *current = loadedTextures.Peek(upload.id)) {
+
+            //Texturen werden vom Caller als Rohwert gehalten (GetTexture(), TextureRequest, TileRenderer), deshalb nur im selben GPU-Objekt ersetzen
+            if (current->width == image.width && current->height == image.height && current->format == image.format && current->mipmaps == 1) {
+                UpdateTexture(*current, image.data);
+                ++reloadGeneration;
+            } else {
+                Debug::Log<Debug::LogLevel::WARNING>("Cannot hot reload texture %s: its size or format changed, restart to pick it up.", name.c_str());
+            }
+
+        }
+
+        //dasselbe Bild kann zusätzlich im Atlas liegen; bei gleicher Größe bleiben alle Sprites gültig, sonst müssen Caches sie neu holen
+        TextureAtlas *spriteAtlas = GetAtlas();
+        if (spriteAtlas != nullptr && spriteAtlas->Contains(upload.id)) {
+
+            if (spriteAtlas->Replace(upload.id, image)) {
+                ++reloadGeneration;
+            }
+            spriteAtlas->Commit();
 
-            ++framePtr;
-            if (framePtr >= frameLayout.size())
-                framePtr = 0;
+        }
 
-        } else if (type == AnimationType::BACK_AND_FORTH) {
+        UnloadImage(upload.image.value());
 
-            if (dir == BackAndForthDirection::INC) {
+    } else if (upload.wave.has_value()) {
 
-                ++framePtr;
-                if (framePtr >= frameLayout.size()) {
-                    framePtr -= 2;
-                    dir = BackAndForthDirection::DEC;
-                }
+        Wave& wave = upload.wave.value();
 
-            } else if (dir == BackAndForthDirection::DEC) {
+        if (const Sound *current = loadedSounds.Peek(upload.id)) {
 
-                --framePtr;
-                if (framePtr < 0) {
-                    framePtr = 1;
-                    dir = BackAndForthDirection::INC;
-                }
+            //Sounds werden vom Caller als Rohwert gehalten und können gerade spielen, deshalb nur im selben Puffer ersetzen
+            WaveFormat(&wave, current->stream.sampleRate, current->stream.sampleSize, current->stream.channels);
 
+            if (wave.frameCount == current->frameCount) {
+                UpdateSound(*current, wave.data, static_cast<int>(wave.frameCount));
+            } else {
+                Debug::Log<Debug::LogLevel::WARNING>("Cannot hot reload sound %s: its length changed, restart to pick it up.", name.c_str());
             }
 
         }
-    }
-
-    const Rectangle frame = frames[frameLayout[framePtr]];
 
-    return {
-        .texture      = atlas,
-        .textureFrame = frame
-    };
+        UnloadWave(wave);
 
-} */
+    } else if (upload.animation.has_value()) {
 
-void Animation::Free() {
+        AnimationData& data = upload.animation.value();
 
-    UnloadTexture(atlas);
+        const AnimationHandle *handle = loadedAnimations.Find(upload.id);
+        if (Animation *animation = handle != nullptr ? Animations().Get(*handle) : nullptr) {
 
-}
+            const Texture2D atlas = UploadAnimationAtlas(data);
+            animation->Reload(atlas, std::move(data.frames), std::move(data.frameLayout), data.fps, data.type);
+            //Frameanzahl und fps können sich geändert haben; das AnimationSystem liest sie daraufhin neu
+            ++reloadGeneration;
 
-/**
- * AssetManager class
- */
+        } else {
 
-AssetManager::AssetManager(AssetManager *parent) {
-    this->parent = parent;
-}
+            UnloadAnimationData(data);
 
-AssetManager::~AssetManager() {
+        }
 
-    for (auto it = loadedTextures.begin(); it != loadedTextures.end(); ++it) {
-        UnloadTexture(it->second);
-    }
+    } else {
 
-    for (auto it = loadedSounds.begin(); it != loadedSounds.end(); ++it) {
-        UnloadSound(it->second);
-    }
+        //z.B. mitten im Schreiben gelesen oder gelöscht; das alte Asset bleibt und das nächste Event versucht es erneut
+        Debug::Log<Debug::LogLevel::WARNING>("Hot reload of %s failed, keeping the previous version.", name.c_str());
 
-    for (auto it = loadedAnimations.begin(); it != loadedAnimations.end(); ++it) {
-        it->second->Free();
     }
 
 }
 
-void AssetManager::AddSearchDir(std::string dir) {
-    searchDirs.emplace_back(dir);
+uint64_t AssetManager::GetReloadGeneration() {
+
+    return reloadGeneration;
+
 }
 
-std::optional<Texture2D> AssetManager::_GetTexture(std::string identifier) {
+size_t AssetManager::ProcessUploads(size_t maxUploads) {
 
-    if (parent != nullptr) {
+    size_t uploaded = 0;
 
-        std::optional<Texture2D> parentRet = parent->_GetTexture(identifier);
-        if (parentRet.has_value()) {
-            return parentRet;
-        }
+    //Atlas-Sprites werden erst fertig, nachdem jeder betroffene Atlas einmal committed hat
+    struct PackedSprite {
+        AssetId id;
+        TextureAtlas *atlas;
+        std::shared_ptr<AssetRequestData<AtlasSprite>> request;
+    };
+    std::vector<TextureAtlas*> touchedAtlases;
+    std::vector<PackedSprite> packedSprites;
 
+    //ohne Watcher nur ein Nullzeigervergleich, im Leerlauf ein atomarer Load pro AssetManager
+    for (AssetManager *manager : LiveManagers()) {
+        manager->ProcessFileEvents();
     }
 
-    if (loadedTextures.contains(identifier)) {
-        return loadedTextures[identifier];
-    }
+    while (uploaded < maxUploads) {
+
+        PendingUpload upload;
 
-    std::vector<std::string> paths;
-    paths.emplace_back(identifier);
-    for (std::string searchDir : searchDirs) {
+        {
+            std::lock_guard<std::mutex> lock(uploadMutex);
+            if (uploadQueue.empty()) {
+                break;
+            }
+            upload = std::move(uploadQueue.front());
+            uploadQueue.pop_front();
+        }
 
-        std::string str = searchDir;
-        str += identifier;
-        paths.emplace_back(str);
+        AssetManager *requester = *upload.requester;
+        AssetManager *owner = upload.owner != nullptr ? *upload.owner : nullptr;
 
-    }
+        if (upload.reload) {
 
-    Image image{};
-    for (std::string path : paths) {
+            if (requester != nullptr) {
+                requester->ApplyReload(upload);
+            } else if (upload.image.has_value()) {
+                UnloadImage(upload.image.value());
+            } else if (upload.wave.has_value()) {
+                UnloadWave(upload.wave.value());
+            } else if (upload.animation.has_value()) {
+                UnloadAnimationData(upload.animation.value());
+            }
 
-        if (!std::filesystem::exists(path)) {
+            ++uploaded;
             continue;
+
         }
 
-        image = LoadImage(path.c_str());
+        if (requester != nullptr) {
+            if (upload.textureRequest != nullptr) {
+                requester->pendingTextures.Erase(upload.id);
+            } else if (upload.soundRequest != nullptr) {
+                requester->pendingSounds.Erase(upload.id);
+            } else {
+                requester->pendingSprites.Erase(upload.id);
+            }
+        }
 
-        if (image.data != nullptr) {
+        if (upload.textureRequest != nullptr) {
 
-            Texture2D texture = LoadTextureFromImage(image);
-            loadedTextures[identifier] = texture;
-            UnloadImage(image);
-            return texture;
+            if (!upload.image.has_value() || owner == nullptr) {
 
-        }
+                if (upload.image.has_value()) {
+                    UnloadImage(upload.image.value());
+                } else if (Debug::Config::LOG_MISSING_ASSETS) {
+                    Debug::Log<Debug::LogLevel::WARNING>("Missing texture: %s", AssetIds::GetName(upload.id).c_str());
+                }
 
-    }
+                upload.textureRequest->state.store(AssetRequestState::FAILED, std::memory_order_release);
+                continue;
 
+            }
 
-    return std::nullopt;
+            PROFILE_ZONE("AssetManager::UploadTexture");
 
-}
+            //kann in der Zwischenzeit synchron geladen worden sein
+            const Texture2D *texture = owner->loadedTextures.Peek(upload.id);
+            if (texture == nullptr) {
+                texture = &owner->loadedTextures.Insert(upload.id, LoadTextureFromImage(upload.image.value()));
+            }
+            UnloadImage(upload.image.value());
 
-std::optional<Texture2D> AssetManager::GetTexture(std::string identifier) {
+            upload.textureRequest->asset = *texture;
+            upload.textureRequest->hold = std::make_shared<TextureHandle>(owner->loadedTextures.Acquire(upload.id));
+            upload.textureRequest->state.store(AssetRequestState::READY, std::memory_order_release);
 
-    const std::optional<Texture2D> ret = _GetTexture(identifier);
+        } else if (upload.soundRequest != nullptr) {
 
-    if (Debug::Config::LOG_MISSING_ASSETS && !ret.has_value()) {
+            if (!upload.wave.has_value() || owner == nullptr) {
 
-        Debug::Log(Debug::LogLevel::WARNING, "Missing texture: %s", identifier.c_str());
+                if (upload.wave.has_value()) {
+                    UnloadWave(upload.wave.value());
+                } else if (Debug::Config::LOG_MISSING_ASSETS) {
+                    Debug::Log<Debug::LogLevel::WARNING>("Missing sound: %s", AssetIds::GetName(upload.id).c_str());
+                }
 
-    }
+                upload.soundRequest->state.store(AssetRequestState::FAILED, std::memory_order_release);
+                continue;
 
-    return ret;
+            }
 
-}
+            PROFILE_ZONE("AssetManager::UploadSound");
 
-std::optional<Sound> AssetManager::_GetSound(std::string identifier) {
+            const Sound *sound = owner->loadedSounds.Peek(upload.id);
+            if (sound == nullptr) {
+                sound = &owner->loadedSounds.Insert(upload.id, LoadSoundFromWave(upload.wave.value()));
+            }
+            UnloadWave(upload.wave.value());
 
-    if (parent != nullptr) {
+            upload.soundRequest->asset = *sound;
+            upload.soundRequest->hold = std::make_shared<SoundHandle>(owner->loadedSounds.Acquire(upload.id));
+            upload.soundRequest->state.store(AssetRequestState::READY, std::memory_order_release);
 
-        std::optional<Sound> parentRet = parent->_GetSound(identifier);
-        if (parentRet.has_value()) {
-            return parentRet;
-        }
+        } else if (upload.spriteRequest != nullptr) {
 
-    }
+            TextureAtlas *atlas = *upload.atlas;
 
-    if (loadedSounds.contains(identifier)) {
-        return loadedSounds[identifier];
-    }
+            if (!upload.image.has_value() || owner == nullptr || atlas == nullptr) {
+
+                if (upload.image.has_value()) {
+                    UnloadImage(upload.image.value());
+                } else if (Debug::Config::LOG_MISSING_ASSETS) {
+                    Debug::Log<Debug::LogLevel::WARNING>("Missing texture: %s", AssetIds::GetName(upload.id).c_str());
+                }
+
+                upload.spriteRequest->state.store(AssetRequestState::FAILED, std::memory_order_release);
+                continue;
 
-    std::vector<std::string> paths;
-    paths.emplace_back(identifier);
-    for (std::string searchDir : searchDirs) {
+            }
+
+            PROFILE_ZONE("AssetManager::PackAtlasSprite");
+
+            //Add() ignoriert Bilder, die schon im Atlas liegen
+            atlas->Add(upload.id, upload.image.value());
+            UnloadImage(upload.image.value());
+
+            if (std::find(touchedAtlases.begin(), touchedAtlases.end(), atlas) == touchedAtlases.end()) {
+                touchedAtlases.push_back(atlas);
+            }
+            packedSprites.push_back({upload.id, atlas, upload.spriteRequest});
+
+        }
 
-        std::string str = searchDir;
-        str += identifier;
-        paths.emplace_back(str);
+        ++uploaded;
 
     }
 
-    Sound sound{};
-    for (std::string path : paths) {
+    if (!touchedAtlases.empty()) {
 
-        if (!std::filesystem::exists(path)) {
-            Debug::Log(Debug::LogLevel::DEBUG, "path does not exist: %s", path.c_str());
-            continue;
+        PROFILE_ZONE("AssetManager::CommitAtlases");
+
+        for (TextureAtlas *atlas : touchedAtlases) {
+            atlas->Commit();
         }
 
-        sound = LoadSound(path.c_str());
-        if (sound.stream.buffer != nullptr) {
+        //die Atlanten leben noch: seit dem Auspacken ihrer Handles oben lief kein fremder Code
+        for (const PackedSprite& packed : packedSprites) {
 
-            loadedSounds[identifier] = sound;
-            return sound;
+            packed.request->asset = packed.atlas->Find(packed.id).value();
+            packed.request->state.store(AssetRequestState::READY, std::memory_order_release);
 
         }
 
     }
 
-    return std::nullopt;
+    return uploaded;
 
 }
 
-std::optional<Sound> AssetManager::GetSound(std::string identifier) {
+void AssetManager::TrimCaches() {
 
-    const std::optional<Sound> ret = _GetSound(identifier);
+    PROFILE_ZONE("AssetManager::TrimCaches");
 
-    if (Debug::Config::LOG_MISSING_ASSETS && !ret.has_value()) {
+    for (AssetManager *manager : LiveManagers()) {
+        manager->loadedTextures.Trim();
+        manager->loadedSounds.Trim();
+    }
 
-        Debug::Log(Debug::LogLevel::WARNING, "Missing sound: %s", identifier.c_str());
+}
 
-    }
+void AssetManager::FreeTexture(AssetId id) {
 
-    return ret;
+    loadedTextures.Free(id);
 
 }
 
-void AssetManager::FreeTexture(std::string identifier) {
-
-    if (loadedTextures.contains(identifier)) {
+void AssetManager::FreeTexture(const std::string& identifier) {
+    FreeTexture(AssetIds::Intern(identifier));
+}
 
-        UnloadTexture(loadedTextures[identifier]);
-        loadedTextures.erase(identifier);
+void AssetManager::FreeSound(AssetId id) {
 
-    }
+    loadedSounds.Free(id);
 
 }
 
-void AssetManager::FreeSound(std::string identifier) {
+void AssetManager::FreeSound(const std::string& identifier) {
+    FreeSound(AssetIds::Intern(identifier));
+}
 
-    if (loadedSounds.contains(identifier)) {
+bool AssetManager::Exists(const std::string& identifier) {
 
-        UnloadSound(loadedSounds[identifier]);
-        loadedSounds.erase(identifier);
+    const AssetId id = AssetIds::Intern(identifier);
 
+    if (parent != nullptr && parent->Exists(identifier)) {
+        return true;
     }
 
+    return ResolvePath(id).has_value();
+
 }
 
-Image AssetManager::LoadRawImage(std::string identifier) {
+Image AssetManager::LoadRawImage(const std::string& identifier) {
+
+    const ArchiveLookup packed = FindInArchives(identifier);
 
-    const Image image = LoadImage(identifier.c_str());
+    const Image image = packed.data.has_value()
+        ? LoadImageFromMemory(GetFileExtension(identifier.c_str()), packed.data->data(), static_cast<int>(packed.data->size()))
+        : LoadImage(identifier.c_str());
 
     if (image.data == nullptr) {
 
         if (Debug::Config::LOG_MISSING_ASSETS) {
 
-            Debug::Log(Debug::LogLevel::WARNING, "Could not load image from path: %s", identifier.c_str());
+            Debug::Log<Debug::LogLevel::WARNING>("Could not load image from path: %s", identifier.c_str());
 
         }
 
@@ -256,23 +1363,27 @@ Image AssetManager::LoadRawImage(std::string identifier) {
 
 }
 
-Texture2D AssetManager::UploadCustomTexture(std::string identifier, Image image) {
+Texture2D AssetManager::UploadCustomTexture(const std::string& identifier, Image image) {
 
-    if (loadedTextures.contains(identifier)) {
+    const AssetId id = AssetIds::Intern(identifier);
 
-        Debug::Log(Debug::LogLevel::WARNING, "A texture is already loaded for identifier %s. Overriding existing texture.", identifier.c_str());
-        UnloadTexture(loadedTextures[identifier]);
+    if (loadedTextures.Peek(id) != nullptr) {
+
+        Debug::Log<Debug::LogLevel::WARNING>("A texture is already loaded for identifier %s. Overriding existing texture.", identifier.c_str());
 
     }
 
-    const Texture2D texture = LoadTextureFromImage(image);
-    loadedTextures[identifier] = texture;
+    //Insert() entlädt eine eventuell vorhandene Textur
+    const Texture2D texture = loadedTextures.Insert(id, LoadTextureFromImage(image));
+    loadedTextures.Pin(id);
 
     return texture;
 
 }
 
-std::optional<std::string> AssetManager::ReadResourceFile(std::string identifier) {
+std::optional<std::string> AssetManager::ReadResourceFile(const std::string& identifier) {
+
+    PROFILE_ZONE("AssetManager::ReadResourceFile");
 
     if (parent != nullptr) {
 
@@ -283,134 +1394,76 @@ std::optional<std::string> AssetManager::ReadResourceFile(std::string identifier
 
     }
 
-    std::vector<std::string> paths;
-    paths.emplace_back(identifier);
-    for (std::string searchDir : searchDirs) {
-
-        std::string str = searchDir;
-        str += identifier;
-        paths.emplace_back(str);
-
+    const std::optional<std::string> path = ResolvePath(AssetIds::Intern(identifier));
+    if (!path.has_value()) {
+        return std::nullopt;
     }
 
-    for (std::string path : paths) {
-
-        if (!std::filesystem::exists(path)) {
-            Debug::Log(Debug::LogLevel::DEBUG, "path does not exist: %s", path.c_str());
-            continue;
-        }
-
-        std::ifstream in(path);
-        if (!in.is_open()) {
-            Debug::Log(Debug::LogLevel::ERROR, "Could not open file %s.", path.c_str());
-            return std::nullopt;
-        }
-        std::ostringstream out;
+    return ReadFileContents(path.value());
 
-        out << in.rdbuf();
+}
 
-        return out.str();
+std::optional<AnimationHandle> AssetManager::GetAnimation(const std::string& identifier) {
+    return GetAnimation(AssetIds::Intern(identifier));
+}
 
-    }
+Animation *AssetManager::ResolveAnimation(AnimationHandle handle) {
 
-    return std::nullopt;
+    return Animations().Get(handle);
 
 }
 
-std::optional<Animation*> AssetManager::GetAnimation(std::string identifier) {
+std::optional<AnimationHandle> AssetManager::GetAnimation(AssetId id) {
 
-    if (parent != nullptr) {
+    //erst alle Caches der Kette, damit ein wiederholter Aufruf weder das Dateisystem noch die Parents nach der Datei fragt
+    for (AssetManager *manager = this; manager != nullptr; manager = manager->parent) {
 
-        std::optional<Animation*> parentRet = parent->GetAnimation(identifier);
-        if (parentRet.has_value()){
-            return parentRet;
+        if (const AnimationHandle *loaded = manager->loadedAnimations.Find(id)) {
+            return *loaded;
         }
 
     }
 
-    if (loadedAnimations.contains(identifier)) {
-        return loadedAnimations[identifier];
-    }
-
-    std::optional<std::string> opt = ReadResourceFile(identifier);
+    PROFILE_ZONE("AssetManager::LoadAnimation");
 
-    if (!opt.has_value()) {
-        Debug::Log(Debug::LogLevel::ERROR, "Could not load animation because file reading failed.");
-        return std::nullopt;
+    //wie bei den übrigen Assets haben die Suchordner der Parents Vorrang; gespeichert wird bei dem AssetManager, der die Datei gefunden hat
+    std::vector<AssetManager*> chain;
+    for (AssetManager *manager = this; manager != nullptr; manager = manager->parent) {
+        chain.push_back(manager);
     }
 
-    Dictionary aniFileContent = ParseDictionary(opt.value(), "\n", "->");
-
-    std::vector<std::string> base64Textures;
-    base64Textures.reserve(ANIMATION_MAX_FRAMES);
-    base64Textures.resize(ANIMATION_MAX_FRAMES);
-    int frameCount;
-    int fps;
-    AnimationType type;
-    std::vector<int> frameLayout;
-
-    for (auto it = aniFileContent.begin(); it != aniFileContent.end(); ++it) {
-
-        std::string key = it->first;
-        std::string value = it->second;
-
-        Debug::Debug("key is %s", key.c_str());
-
-        if (IsPositiveInt(key)) {
-            int index = std::stoi(key);
-            base64Textures[index] = value;
-        } else if (key.compare("typ") == 0 || key.compare("type") == 0) {
-
-            if (value.compare("back/forth") == 0) {
-                type = AnimationType::BACK_AND_FORTH;
-            } else if (value.compare("looping") == 0) {
-                type = AnimationType::LOOPING;
-            } else {
-                Debug::Log(Debug::LogLevel::ERROR, "Could not parse .ani file: Unknown animation type '%s'.", value.c_str());
-                return std::nullopt;
-            }
-
-        } else if (key.compare("fps") == 0) {
+    bool found = false;
 
-            fps = std::stoi(value);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
 
-        } else if (key.compare("frames") == 0) {
-
-            frameLayout = ParsePositiveIntList(value, ",");
+        AssetManager *owner = *it;
+        const std::optional<std::string> path = owner->ResolvePath(id);
 
+        if (!path.has_value()) {
+            continue;
         }
+        found = true;
 
-    }
-    frameCount = frameLayout.size();
-
-    std::vector<Texture2D> loadedTextures;
-    for (int index = 0; index < base64Textures.size(); ++index) {
-        std::string data = base64Textures[index];
+        std::optional<AnimationData> data = DecodeAnimation(path.value());
 
-        if (data.empty()) continue;
-
-        const std::string prefix = "data:image/png;base64,";
-        if (data.rfind(prefix, 0) == 0) {
-            data = data.substr(prefix.size());
+        if (!data.has_value()) {
+            continue;
         }
 
-        std::vector<unsigned char> decoded = Base64Decode(data);
+        const Texture2D spriteAtlas = UploadAnimationAtlas(data.value());
 
-        Image image = LoadImageFromMemory(".png", decoded.data(), decoded.size());
+        const AnimationHandle handle = Animations().Emplace(spriteAtlas, std::move(data->frames), std::move(data->frameLayout), data->fps, data->type);
 
-        Texture2D texture = LoadTextureFromImage(image);
-        loadedTextures.push_back(texture);
+        owner->loadedAnimations.Set(id, handle);
+        return handle;
 
-        UnloadImage(image);
     }
 
-    std::vector<Rectangle> frames;
-    Texture2D spriteAtlas = BuildSpriteAtlas(loadedTextures, &frames);
-
-    Animation *animation = animationAllocator.Alloc<Animation>();
-    *animation = Animation(spriteAtlas, frames, frameLayout, fps, type);
+    if (!found) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not load animation %s because the file was not found.", AssetIds::GetName(id).c_str());
+    }
 
-    return animation;
+    return std::nullopt;
 
 }
 
@@ -418,363 +1471,224 @@ std::optional<Animation*> AssetManager::GetAnimation(std::string identifier) {
  * FontRenderer class
  */
 
-FontRenderer::FontRenderer(std::string fontDir) {
+FontRenderer::FontRenderer(std::string fontDir, TextureAtlas *atlas) {
 
     fontAssetManager.AddSearchDir(fontDir);
+    fontAssetManager.SetAtlas(atlas);
 
 }
 
-Texture2D FontRenderer::GetCharTexture(char c) {
-
-    //Buchstabentexturen werden nochmal extra gecached (obwohl der AssetManager das auch schon tut), um die Ermittlung des korrekten Texturenpfades nicht bei jedem Aufruf durchlaufen zu müssen.
-    if (cachedTextures.contains(c)) {
-
-        return cachedTextures[c];
-
+//Für manche Buchstaben brauchen wir besonderes Handling. Standardverhalten: Großbuchstabe + ".png" -> Dateiname innerhalb des Font-Ordners.
+//Gibt einen leeren String zurück, wenn der Codepoint kein Bild haben kann.
+static std::string GlyphFileName(char32_t codepoint) {
+
+    switch (codepoint) {
+        case U':': return "colon.png";
+        case U'.': return "period.png";
+        case U'?': return "questionmark.png";
+        case U'/': return "slash.png";
+        case U'Ä': case U'ä': return "AE.png";
+        case U'Ö': case U'ö': return "OE.png";
+        case U'Ü': case U'ü': return "UE.png";
+        case U'ß': return "sz.png";
+        default: break;
     }
 
-    std::optional<Texture2D> texture = std::nullopt;
-
-    //Für manche Buchstaben brauchen wir besonders Handling. Standardverhalten: Großbuchstabe + ".png" -> Dateiname innerhalb des Font-Ordners.
-    switch (c) {
-        case ':': {
-            texture = fontAssetManager.GetTexture("colon.png");
-        } break;
-        case '.': {
-            texture = fontAssetManager.GetTexture("period.png");
-        } break;
-        case '?': {
-            texture = fontAssetManager.GetTexture("questionmark.png");
-        } break;
-        case '/': {
-            texture = fontAssetManager.GetTexture("slash.png");
-        } break;
-        default: {
-            c = std::toupper(c);
-            std::string str = "";
-            str += c;
-            str += ".png";
-
-            texture = fontAssetManager.GetTexture(str);
-        } break;
-        
+    //sichtbare ASCII-Zeichen; Leerzeichen wird nicht gezeichnet, sondern nur übersprungen
+    if (codepoint <= U' ' || codepoint >= 0x7F) {
+        return "";
     }
 
-    if (texture.has_value()) {
+    std::string str = "";
+    str += static_cast<char>(std::toupper(static_cast<int>(codepoint)));
+    str += ".png";
+    return str;
 
-        cachedTextures[c] = texture.value();
-        return texture.value();
-
-    } else {
+}
 
-        Debug::Log(Debug::LogLevel::ERROR, "Font Renderer: Could not find texture for character '%c'", c);
-        return Texture2D{};
+void FontRenderer::CheckReloadGeneration() {
 
+    //nach einem Hot Reload können Sprites an eine andere Stelle im Atlas gewandert sein, und mit ihnen die Quads der Layouts
+    if (cachedGeneration != AssetManager::GetReloadGeneration()) {
+        glyphsLoaded = false;
+        layoutIndex.clear();
+        layoutLru.clear();
+        cachedGeneration = AssetManager::GetReloadGeneration();
     }
 
 }
 
-void FontRenderer::DrawString(std::string str, Vector2 position, float scaleFactor) {
-
-    const char *text = str.c_str();
-    size_t index = 0;
+void FontRenderer::LoadGlyphs() {
 
-    const float y = position.y;
-    float x = position.x;
+    PROFILE_ZONE("FontRenderer::LoadGlyphs");
 
-    while (text[index] != '\0') {
+    //nur Dateien anfragen, die es im Font-Ordner gibt (der Index des AssetManagers macht das ohne Dateisystemzugriff),
+    //damit fehlende Zeichen wie '#' keine Warnungen erzeugen. Mehrere Codepoints können sich ein Bild teilen (ä und Ä).
+    std::array<std::optional<AtlasSpriteRequest>, GLYPH_TABLE_SIZE> requests;
+    std::unordered_map<std::string, AtlasSpriteRequest> requestsByFile;
 
-        if (text[index] == ' ') {
+    for (char32_t codepoint = 0; codepoint < GLYPH_TABLE_SIZE; ++codepoint) {
 
-            x += (spaceWidth * scaleFactor);
-            ++index;
+        const std::string file = GlyphFileName(codepoint);
+        if (file.empty()) {
             continue;
-
         }
 
-        const Texture2D texture = GetCharTexture(text[index]);
-
-        //fehlerhaft geladene texturen überspringen
-        if (texture.id == 0) {
-            ++index;
-            continue;
+        if (const auto it = requestsByFile.find(file); it != requestsByFile.end()) {
+            requests[codepoint] = it->second;
+        } else if (fontAssetManager.Exists(file)) {
+            requests[codepoint] = requestsByFile.emplace(file, fontAssetManager.RequestAtlasSprite(file)).first->second;
         }
 
-        const Rectangle sourceRec{0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)};
-        const Rectangle destRec{x, y, static_cast<float>(texture.width * scaleFactor), static_cast<float>(texture.height * scaleFactor)};
-        constexpr Vector2 origin{0, 0};
-        constexpr float rotation{0};
-        constexpr Color NO_TINT = WHITE;
-
-        DrawTexturePro(texture, sourceRec, destRec, origin, rotation, NO_TINT);
-
-        x += (texture.width * scaleFactor);
-        ++index;
-
     }
 
-}
-
-Vector2 FontRenderer::MeasureString(std::string str, float scaleFactor) {
+    //alle Bilder sind jetzt gleichzeitig unterwegs: parallel dekodiert und mit einem Upload pro Atlasseite in den Atlas gepackt
+    for (size_t codepoint = 0; codepoint < GLYPH_TABLE_SIZE; ++codepoint) {
 
-    const char *text = str.c_str();
-    size_t index = 0;
+        glyphs[codepoint] = requests[codepoint].has_value() ? requests[codepoint]->Wait().value_or(AtlasSprite{}) : AtlasSprite{};
 
-    float width = 0, height = 0;
-
-    while (text[index] != '\0') {
-
-        if (text[index] == ' ') {
-
-            width += (spaceWidth * scaleFactor);
-            ++index;
-            continue;
-
-        }
+    }
 
-        const Texture2D texture = GetCharTexture(text[index]);
+    glyphsLoaded = true;
 
-        //fehlerhaft geladene texturen überspringen
-        if (texture.id == 0) {
-            ++index;
-            continue;
-        }
+}
 
-        const float textureHeight = texture.height * scaleFactor;
-        if (textureHeight > height) {
-            height = textureHeight;
-        }
+TextLayout FontRenderer::Layout(std::string_view str, float scaleFactor) {
 
-        width += (texture.width * scaleFactor);
-        ++index;
+    CheckReloadGeneration();
 
+    if (!glyphsLoaded) {
+        LoadGlyphs();
     }
 
-    return {width, height};
-
-}
-
-Vector2 FontRenderer::DrawStringAndMeasure(std::string str, Vector2 position, float scaleFactor) {
-
-    const char *text = str.c_str();
-    size_t index = 0;
+    TextLayout layout;
+    layout.glyphs.reserve(str.size());
 
-    const float y = position.y;
-    float x = position.x;
+    float x = 0;
 
-    float height = 0;
+    for (size_t index = 0; index < str.size();) {
 
-    while (text[index] != '\0') {
+        const char32_t codepoint = DecodeUtf8(str, index);
 
-        if (text[index] == ' ') {
+        if (codepoint == U' ') {
 
             x += (spaceWidth * scaleFactor);
-            ++index;
             continue;
 
         }
 
-        const Texture2D texture = GetCharTexture(text[index]);
+        //fehlende Buchstaben werden übersprungen, aber einmal gemeldet
+        if (codepoint >= GLYPH_TABLE_SIZE || glyphs[codepoint].texture.id == 0) {
 
-        //fehlerhaft geladene texturen überspringen
-        if (texture.id == 0) {
-            ++index;
+            bool firstReport;
+            if (codepoint < GLYPH_TABLE_SIZE) {
+                firstReport = !reportedMissing[codepoint];
+                reportedMissing[codepoint] = true;
+            } else {
+                firstReport = reportedMissingOutsideTable.insert(codepoint).second;
+            }
+
+            if (firstReport) {
+                Debug::Log<Debug::LogLevel::ERROR>("Font Renderer: Could not find texture for character U+%04X", static_cast<unsigned int>(codepoint));
+            }
             continue;
-        }
 
-        const float textureHeight = texture.height * scaleFactor;
-        if (textureHeight > height) {
-            height = textureHeight;
         }
 
-        const Rectangle sourceRec{0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)};
-        const Rectangle destRec{x, y, static_cast<float>(texture.width * scaleFactor), static_cast<float>(texture.height * scaleFactor)};
-        constexpr Vector2 origin{0, 0};
-        constexpr float rotation{0};
-        constexpr Color NO_TINT = WHITE;
-
-        DrawTexturePro(texture, sourceRec, destRec, origin, rotation, NO_TINT);
-
-        x += (texture.width * scaleFactor);
-        ++index;
+        const AtlasSprite& glyph = glyphs[codepoint];
 
-    }
+        const float width = glyph.source.width * scaleFactor;
+        const float height = glyph.source.height * scaleFactor;
 
-    return {x, height};
+        layout.glyphs.push_back({glyph.texture, glyph.source, {x, 0, width, height}});
+        layout.size.y = std::max(layout.size.y, height);
 
-}
+        x += width;
 
-/**
- * SoundQueue class
- */
+    }
 
-SoundQueue::SoundQueue() : silenceTimer(1), fadeTimer(1) {}
+    layout.size.x = x;
 
-void SoundQueue::QueueSilence(int silenceMillis) {
-    SoundQueueEntry sqe{};
-    sqe.isSilence = true;
-    sqe.silenceMillis = silenceMillis;
-    queuedSounds.emplace(sqe);
-    if (IsEmpty())
-        BeginPlaying();
-}
+    return layout;
 
-void SoundQueue::Queue(Sound sound) {
-    SoundQueueEntry sqe{};
-    sqe.isSilence = false;
-    sqe.sound = sound;
-    const bool wasEmpty = IsEmpty();
-    queuedSounds.emplace(sqe);
-    if (wasEmpty)
-        BeginPlaying();
 }
 
-void SoundQueue::QueueFadeIn(Sound sound, int fadeInMillis) {
-    SoundQueueEntry sqe{};
-    sqe.sound = sound;
-    sqe.fadeIn = true;
-    sqe.fadeInMillis = fadeInMillis;
-    const bool wasEmpty = IsEmpty();
-    queuedSounds.emplace(sqe);
-    if (wasEmpty)
-        BeginPlaying();
-}
+size_t FontRenderer::LayoutKeyHash::operator()(const LayoutKey& key) const {
 
-void SoundQueue::QueueLooping(Sound sound) {
-    SoundQueueEntry sqe{};
-    sqe.sound = sound;
-    sqe.looping = true;
-    const bool wasEmpty = IsEmpty();
-    queuedSounds.emplace(sqe);
-    if (wasEmpty)
-        BeginPlaying();
-}
+    return std::hash<std::string_view>{}(key.text) ^ (std::hash<float>{}(key.scaleFactor) * 31);
 
-void SoundQueue::QueueLoopingFadeIn(Sound sound, int fadeInMillis) {
-    SoundQueueEntry sqe{};
-    sqe.sound = sound;
-    sqe.looping = true;
-    sqe.fadeIn = true;
-    sqe.fadeInMillis = fadeInMillis;
-    const bool wasEmpty = IsEmpty();
-    queuedSounds.emplace(sqe);
-    if (wasEmpty)
-        BeginPlaying();
 }
 
-void SoundQueue::SkipToNext() {
-    queuedSounds.pop();
-    BeginPlaying();
-}
+const TextLayout& FontRenderer::GetCachedLayout(std::string_view str, float scaleFactor) {
 
-void SoundQueue::FadeOutAndSkipToNext(int fadeOutMillis) {
+    CheckReloadGeneration();
 
-    fadeTimer.Reset();
-    fadeMillis = fadeOutMillis;
-    state = SoundQueueState::FADING_OUT;
+    if (const auto it = layoutIndex.find(LayoutKey{str, scaleFactor}); it != layoutIndex.end()) {
 
-}
+        layoutLru.splice(layoutLru.begin(), layoutLru, it->second);
+        return it->second->layout;
 
-void SoundQueue::BeginPlaying() {
-    if (queuedSounds.empty()) {
-        state = SoundQueueState::EMPTY;
-        return;
-    }
-    SoundQueueEntry entry = queuedSounds.front();
-    if (entry.isSilence) {
-        silenceTimer.Reset();
-        state = SoundQueueState::SILENCE;
-        return;
-    }
-    if (entry.fadeIn) {
-        state = SoundQueueState::FADING_IN;
-        fadeMillis = entry.fadeInMillis;
-        fadeTimer.Reset();
-        SetSoundVolume(entry.sound, 0);
-    } else {
-        state = SoundQueueState::PLAYING;
-        SetSoundVolume(entry.sound, 1.0f);
     }
-    PlaySound(entry.sound);
-}
 
-void SoundQueue::Update() {
+    //erst setzen, dann verdrängen: Layout() lädt beim ersten Mal die Buchstaben und arbeitet dabei die Upload-Queue ab, was den Cache leeren kann
+    TextLayout layout = Layout(str, scaleFactor);
 
-    if (queuedSounds.empty())
-        return;
-
-    SoundQueueEntry entry = queuedSounds.front();
-    if (entry.isSilence) {
-
-        if (silenceTimer.GetElapsedMillis() >= entry.silenceMillis) {
-            queuedSounds.pop();
-            BeginPlaying();
-        }
+    if (layoutLru.size() >= LAYOUT_CACHE_CAPACITY) {
 
-    } else {
+        const CachedLayout& oldest = layoutLru.back();
+        layoutIndex.erase(LayoutKey{oldest.text, oldest.scaleFactor});
+        layoutLru.pop_back();
 
-        Sound sound = entry.sound;
-        if (!IsSoundPlaying(sound)) {
+    }
 
-            if (entry.looping) {
-                PlaySound(sound);
-            } else {
-                queuedSounds.pop();
-                BeginPlaying();
-            }
+    layoutLru.push_front({std::string(str), scaleFactor, std::move(layout)});
+    layoutIndex.emplace(LayoutKey{layoutLru.front().text, scaleFactor}, layoutLru.begin());
 
-        }
+    return layoutLru.front().layout;
 
-    }
+}
 
-    if (state == SoundQueueState::FADING_IN) {
+void FontRenderer::DrawLayout(const TextLayout& layout, Vector2 position, Color tint) {
 
-        Sound sound = entry.sound;
-        const int elapsedMillis = static_cast<int>(fadeTimer.GetElapsedMillis());
+    SpriteBatch& target = batch != nullptr ? *batch : ownBatch;
 
-        if (elapsedMillis >= fadeMillis) {
+    for (const TextLayoutGlyph& glyph : layout.glyphs) {
 
-            state = SoundQueueState::PLAYING;
-            SetSoundVolume(sound, 1.0f);
+        const Rectangle destRec{position.x + glyph.dest.x, position.y + glyph.dest.y, glyph.dest.width, glyph.dest.height};
+        target.Draw(glyph.texture, glyph.source, destRec, tint);
 
-        } else {
+    }
 
-            const float ratio = (elapsedMillis * 1.0f) / (fadeMillis * 1.0f);
-            SetSoundVolume(sound, ratio);
+    if (batch == nullptr) {
+        ownBatch.Flush();
+    }
 
-        }
+}
 
-    } else if (state == SoundQueueState::FADING_OUT) {
+void FontRenderer::DrawString(std::string_view str, Vector2 position, float scaleFactor) {
 
-        Sound sound = entry.sound;
-        const int elapsedMillis = static_cast<int>(fadeTimer.GetElapsedMillis());
+    DrawLayout(GetCachedLayout(str, scaleFactor), position);
 
-        if (elapsedMillis >= fadeMillis) {
+}
 
-            queuedSounds.pop();
-            BeginPlaying();
+Vector2 FontRenderer::MeasureString(std::string_view str, float scaleFactor) {
 
-        } else {
+    return GetCachedLayout(str, scaleFactor).size;
 
-            const float ratio = (elapsedMillis * 1.0f) / (fadeMillis * 1.0f);
-            SetSoundVolume(sound, 1-ratio);
+}
 
-        }
+Vector2 FontRenderer::DrawStringAndMeasure(std::string_view str, Vector2 position, float scaleFactor) {
 
-    }
+    const TextLayout& layout = GetCachedLayout(str, scaleFactor);
+    DrawLayout(layout, position);
 
-}
+    return {position.x + layout.size.x, layout.size.y};
 
-bool SoundQueue::IsEmpty() {
-    return queuedSounds.empty();
 }
 
-void SoundQueue::Clear() {
+void FontRenderer::SetSpriteBatch(SpriteBatch *batch) {
 
-    while (!queuedSounds.empty()) 
-        queuedSounds.pop();
-    
-    state = SoundQueueState::EMPTY;
+    this->batch = batch;
 
 }
 
@@ -782,30 +1696,31 @@ void SoundQueue::Clear() {
  * Free functions
  */
 
-Dictionary ParseDictionary(std::string str, std::string entryDelimiter, std::string kvDelimiter) {
+Dictionary ParseDictionary(const std::string& str, const std::string& entryDelimiter, const std::string& kvDelimiter) {
 
     Dictionary out;
 
-    size_t newLinePos = -1;
-    while ((newLinePos = str.find(entryDelimiter)) != std::string::npos) {
-        std::string entry = str.substr(0, newLinePos);
+    //nur Positionen weiterschieben statt den Anfang des Strings abzuschneiden, sonst wird jede Zeile erneut kopiert
+    size_t entryStart = 0;
+    while (entryStart < str.size()) {
 
-        size_t delimiterPos = entry.find(kvDelimiter);
-        std::string key = entry.substr(0, delimiterPos);
-        std::string value = entry.substr(delimiterPos+kvDelimiter.size(), entry.size());
-
-        out[key] = value;
+        size_t entryEnd = str.find(entryDelimiter, entryStart);
+        if (entryEnd == std::string::npos) {
+            entryEnd = str.size();
+        }
 
-        str.erase(0, newLinePos + entryDelimiter.size());
-    }
+        const std::string_view entry(str.data() + entryStart, entryEnd - entryStart);
+        const size_t delimiterPos = entry.find(kvDelimiter);
 
-    if (!str.empty()) {
-        size_t delimiterPos = str.find(kvDelimiter);
-        if (delimiterPos != std::string::npos) {
-            std::string key = str.substr(0, delimiterPos);
-            std::string value = str.substr(delimiterPos + kvDelimiter.size());
-            out[key] = value;
+        //die letzte Zeile ohne Trennzeichen zählt nur, wenn sie ein Schlüssel-Wert-Paar ist
+        if (delimiterPos != std::string_view::npos || entryEnd != str.size()) {
+            std::string key(entry.substr(0, delimiterPos));
+            std::string value(delimiterPos == std::string_view::npos ? std::string_view() : entry.substr(delimiterPos + kvDelimiter.size()));
+            out.insert_or_assign(std::move(key), std::move(value));
         }
+
+        entryStart = entryEnd + entryDelimiter.size();
+
     }
 
     return out;
@@ -824,28 +1739,95 @@ bool IsPositiveInt(const std::string& str) {
 
 }
 
-std::vector<int> ParsePositiveIntList(std::string str, std::string delimiter) {
+std::vector<int> ParsePositiveIntList(const std::string& str, const std::string& delimiter) {
 
     std::vector<int> out;
 
-    size_t delimiterPos = -1;
-    while ((delimiterPos = str.find(delimiter)) != std::string::npos) {
-        std::string num = str.substr(0, delimiterPos);
+    size_t start = 0;
+    while (start <= str.size()) {
+
+        size_t end = str.find(delimiter, start);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+
+        const std::string num = str.substr(start, end - start);
+        start = end + delimiter.size();
+
+        //leerer Rest nach einem abschließenden Trennzeichen
+        if (num.empty() && end == str.size()) {
+            break;
+        }
 
-        if (!IsPositiveInt(num)) {
-            Debug::Log(Debug::LogLevel::WARNING, "While trying to parse positive int list, entry '%s' was not a positive integer. Skipping entry.", str.c_str());
+        if (num.empty() || !IsPositiveInt(num)) {
+            Debug::Log<Debug::LogLevel::WARNING>("While trying to parse positive int list, entry '%s' was not a positive integer. Skipping entry.", num.c_str());
             continue;
         }
 
         out.emplace_back(std::stoi(num));
 
-        str.erase(0, delimiterPos + delimiter.size());
     }
 
     return out;
 
 }
 
+char32_t DecodeUtf8(std::string_view str, size_t& index) {
+
+    static constexpr char32_t REPLACEMENT = 0xFFFD;
+
+    const unsigned char lead = static_cast<unsigned char>(str[index]);
+
+    if (lead < 0x80) {
+        ++index;
+        return lead;
+    }
+
+    size_t length = 0;
+    char32_t codepoint = 0;
+
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+    } else {
+        ++index;
+        return REPLACEMENT;
+    }
+
+    if (index + length > str.size()) {
+        ++index;
+        return REPLACEMENT;
+    }
+
+    for (size_t i = 1; i < length; ++i) {
+
+        const unsigned char continuation = static_cast<unsigned char>(str[index + i]);
+        if ((continuation & 0xC0) != 0x80) {
+            ++index;
+            return REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+
+    }
+
+    //überlange Kodierungen und Surrogates sind ungültig
+    static constexpr char32_t MIN_CODEPOINT[5] = {0, 0, 0x80, 0x800, 0x10000};
+    if (codepoint < MIN_CODEPOINT[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        ++index;
+        return REPLACEMENT;
+    }
+
+    index += length;
+    return codepoint;
+
+}
+
 //aus dem internet gekalut
 //hoffentlich funktioniert das auch
 std::vector<unsigned char> Base64Decode(const std::string& in) {
@@ -869,33 +1851,3 @@ std::vector<unsigned char> Base64Decode(const std::string& in) {
     }
     return out;
 }
-
-Texture2D BuildSpriteAtlas(const std::vector<Texture2D>& textures, std::vector<Rectangle> *frameInfoOutput) {
-
-    const int frameCount = (int)textures.size();
-    const int frameWidth = textures[0].width;
-    const int frameHeight = textures[0].height;
-
-    RenderTexture2D target = LoadRenderTexture(frameCount * frameWidth, frameHeight);
-    BeginTextureMode(target);
-    ClearBackground(BLANK);
-
-    for (int i = 0; i < frameCount; i++) {
-        DrawTexture(textures[i], i * frameWidth, 0, WHITE);
-    }
-
-    EndTextureMode();
-
-    Texture2D atlas = target.texture;
-    Image atlasImg = LoadImageFromTexture(target.texture);
-    atlas = LoadTextureFromImage(atlasImg);
-    UnloadImage(atlasImg);
-    UnloadRenderTexture(target);
-
-    frameInfoOutput->resize(frameCount);
-    for (int i = 0; i < frameCount; i++) {
-        (*frameInfoOutput)[i] = { (float)(i * frameWidth), 0.0f, (float)frameWidth, (float)frameHeight };
-    }
-
-    return atlas;
-}
\ No newline at end of file
@@ -2,170 +2,460 @@
 
 #include "../../include/raylib.h"
 
-#include "timer.h"
-#include "allocator.h"
+#include "archive.h"
+#include "assetid.h"
+#include "assetcache.h"
+#include "animfile.h"
+#include "atlas.h"
+#include "mixer.h"
+#include "render.h"
+#include "slotmap.h"
 
+#include "../io/filewatcher.h"
+
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <functional>
+#include <list>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <queue>
+#include <span>
+#include <thread>
 
-enum class AnimationType {
+/**
+ * Die Definition einer Animation: Atlas, Frames und Abspielart. Sie enthält keinen Abspielzustand; den führt das AnimationSystem,
+ * damit beliebig viele Instanzen eine Definition teilen können.
+ * Eine Animation braucht mindestens 2 Frames, ansonsten passieren komische Sachen (array out of bounds).
+ */
+class Animation final {
+    public:
+        Animation(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type);
+        void Free();
+        /**
+         * Ersetzt Atlas und Frames (beim Hot Reload), der alte Atlas wird entladen. Handles auf die Animation bleiben gültig.
+         */
+        void Reload(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type);
+        Texture2D GetAtlas() const;
+        /**
+         * Das Quellrechteck im Atlas für den step-ten Schritt der Abspielreihenfolge.
+         */
+        Rectangle GetFrame(size_t step) const;
+        /**
+         * Anzahl der Schritte in der Abspielreihenfolge (nicht der unterschiedlichen Bilder).
+         */
+        size_t GetStepCount() const;
+        int GetFps() const;
+        AnimationType GetType() const;
+    private:
+        Texture2D atlas;
+        std::vector<Rectangle> frames;
+        std::vector<int> frameLayout;
+        int fps;
+        AnimationType type;
+};
 
-    LOOPING, BACK_AND_FORTH
+using AnimationHandle = SlotHandle<Animation>;
 
+/**
+ * Ergebnis einer Suche in den gemounteten Archiven. covered ist true, wenn der Pfad unter einem Mountpoint liegt;
+ * das Archiv ist dann maßgeblich und das Dateisystem wird für diesen Pfad nicht mehr gefragt.
+ */
+struct ArchiveLookup {
+    bool covered;
+    std::optional<std::span<const unsigned char>> data;
 };
 
-enum class BackAndForthDirection {
-    INC, DEC
+enum class AssetRequestState {
+
+    LOADING, READY, FAILED
+
 };
 
-inline constexpr size_t ANIMATION_MAX_FRAMES = 32;
+template<typename T>
+struct AssetRequestData {
+    std::atomic<AssetRequestState> state{AssetRequestState::LOADING};
+    T asset{};
+    //hält den Cache-Eintrag von asset fest, solange eine Kopie des Requests lebt; leer bei Atlas-Sprites, die der Atlas selbst hält
+    std::shared_ptr<void> hold;
+};
 
-//Eine Animation braucht mindestens 2 Frames, ansonsten passieren komische Sachen (array out of bounds).
-class Animation final {
+/**
+ * Handle auf ein Asset, das im Hintergrund geladen wird. Dekodiert wird auf dem Threadpool, hochgeladen in AssetManager::ProcessUploads() auf dem Main-Thread.
+ * Das Handle kann beliebig kopiert werden; alle Kopien sehen dasselbe Asset. Solange eine Kopie lebt, wird das Asset nicht verdrängt,
+ * der Rohwert aus Get() ist also so lange gültig wie das Request. Kopien nur auf dem Main-Thread zerstören.
+ */
+template<typename T>
+class AssetRequest {
     public:
-        Animation(Texture2D spriteAtlas, std::vector<Rectangle> frames, std::vector<int> frameLayout, int fps, AnimationType type);
-        void Free();
+        AssetRequest() = default;
+        explicit AssetRequest(std::shared_ptr<AssetRequestData<T>> data) : data(std::move(data)) {}
+        bool IsValid() const {
+            return data != nullptr;
+        }
+        bool IsReady() const {
+            return data != nullptr && data->state.load(std::memory_order_acquire) == AssetRequestState::READY;
+        }
+        bool IsFailed() const {
+            return data != nullptr && data->state.load(std::memory_order_acquire) == AssetRequestState::FAILED;
+        }
+        /**
+         * Gibt das Asset zurück, wenn es fertig geladen ist. Blockiert nie.
+         */
+        std::optional<T> Get() const {
+            if (!IsReady()) {
+                return std::nullopt;
+            }
+            return data->asset;
+        }
+        /**
+         * Wartet bis das Asset fertig oder fehlgeschlagen ist und arbeitet dabei selbst die Upload-Queue ab. Nur auf dem Main-Thread aufrufen.
+         */
+        std::optional<T> Wait() const;
     private:
-        Texture2D atlas;
-        std::vector<Rectangle> frames;
-        std::vector<int> frameLayout;
-        int framePtr = 0;
+        std::shared_ptr<AssetRequestData<T>> data;
+};
 
-        AnimationType type;
-        //wird nur benutzt wenn type == BACK_AND_FORTH
-        BackAndForthDirection dir = BackAndForthDirection::INC;
-        TickTimer timer;
+using TextureRequest = AssetRequest<Texture2D>;
+using SoundRequest = AssetRequest<Sound>;
+using AtlasSpriteRequest = AssetRequest<AtlasSprite>;
+
+struct TextureCacheBackend {
+    size_t Bytes(const Texture2D& texture) const;
+    void Unload(Texture2D& texture);
+};
+
+struct SoundCacheBackend {
+    size_t Bytes(const Sound& sound) const;
+    void Unload(Sound& sound);
 };
 
+using TextureCache = AssetCache<Texture2D, TextureCacheBackend>;
+using SoundCache = AssetCache<Sound, SoundCacheBackend>;
+using TextureHandle = TextureCache::Handle;
+using SoundHandle = SoundCache::Handle;
+
+/**
+ * Standardbudgets pro AssetManager. Gepinnte und über Handles referenzierte Assets zählen mit, werden aber nie verdrängt.
+ */
+inline constexpr size_t DEFAULT_TEXTURE_BUDGET_BYTES = 256 * 1024 * 1024;
+inline constexpr size_t DEFAULT_SOUND_BUDGET_BYTES = 128 * 1024 * 1024;
+
+struct PendingUpload;
+
 class AssetManager {
     public:
-        AssetManager() = default;
+        AssetManager();
         AssetManager(AssetManager *parent);
         ~AssetManager();
+        AssetManager(const AssetManager&) = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
         /**
          * Fügt einen Suchordner hinzu. Asset-Suche ist nicht rekursiv, Unterordner müssen explizit hinzugefügt werden.
+         * Der Ordner wird dabei einmal indiziert; danach kostet die Suche nach einem Asset keine Dateisystemzugriffe mehr, auch wenn es nicht existiert.
          */
         void AddSearchDir(std::string dir);
         /**
          * Findet eine Textur. Wenn diese nicht geladen ist wird sie anhand des Parameters und der angegebenen Suchordner geladen.
+         * Für häufige Zugriffe (z.B. jeden Frame) die AssetId-Variante mit ASSET_ID("...") benutzen, das spart das Hashen des Strings.
+         * Da der Caller den Rohwert behalten darf, wird die Textur gepinnt und bleibt bis FreeTexture() geladen. Verdrängbar sind nur Texturen aus AcquireTexture() und RequestTexture().
+         * Ein Hot Reload ersetzt nur die Pixel im selben GPU-Objekt, der Rohwert bleibt also gültig; geänderte Größen werden erst nach einem Neustart übernommen.
          */
-        std::optional<Texture2D> GetTexture(std::string identifier);
+        std::optional<Texture2D> GetTexture(AssetId id);
+        std::optional<Texture2D> GetTexture(const std::string& identifier);
         /**
          * Findet einen Sound. Wenn dieser nicht geladen ist wird er anhand des Parameters und der angegebenen Suchordner geladen.
          */
-        std::optional<Sound> GetSound(std::string identifier);
+        std::optional<Sound> GetSound(AssetId id);
+        std::optional<Sound> GetSound(const std::string& identifier);
         /**
-         * Entlädt einen spezifischen Sound. Muss nicht zwingend verwendet werden, da bei der Zerstörung des AssetManagers alle Sounds entladen werden.
+         * Öffnet eine .wav Datei zum gestreamten Abspielen, für lange Musikstücke statt GetSound(). Jeder Aufruf liefert einen eigenen Stream,
+         * der nicht im AssetManager gespeichert wird. Gibt nullptr zurück, wenn die Datei fehlt oder nicht gestreamt werden kann.
          */
-        void FreeTexture(std::string identifier);
+        std::shared_ptr<MusicStream> OpenMusicStream(AssetId id);
+        std::shared_ptr<MusicStream> OpenMusicStream(const std::string& identifier);
         /**
          * Entlädt eine spezifische Textur. Muss nicht zwingend verwendet werden, da bei der Zerstörung des AssetManagers alle Texturen entladen werden.
          */
-        void FreeSound(std::string identifier);
+        void FreeTexture(AssetId id);
+        void FreeTexture(const std::string& identifier);
+        /**
+         * Entlädt einen spezifischen Sound. Muss nicht zwingend verwendet werden, da bei der Zerstörung des AssetManagers alle Sounds entladen werden.
+         */
+        void FreeSound(AssetId id);
+        void FreeSound(const std::string& identifier);
+        /**
+         * Wie GetTexture(), gibt aber ein referenzgezähltes Handle zurück. Ist das letzte Handle weg, darf die Textur bei Budgetüberschreitung verdrängt werden;
+         * ein späterer Zugriff lädt sie dann neu.
+         */
+        std::optional<TextureHandle> AcquireTexture(AssetId id);
+        std::optional<TextureHandle> AcquireTexture(const std::string& identifier);
+        /**
+         * Wie GetSound(), siehe AcquireTexture().
+         */
+        std::optional<SoundHandle> AcquireSound(AssetId id);
+        std::optional<SoundHandle> AcquireSound(const std::string& identifier);
+        void SetTextureBudget(size_t bytes);
+        void SetSoundBudget(size_t bytes);
+        const AssetCacheStats& GetTextureStats() const;
+        const AssetCacheStats& GetSoundStats() const;
+        /**
+         * Ob identifier in den Suchordnern dieses AssetManagers oder eines Parents liegt. Kostet dank des Suchindex keinen Dateisystemzugriff.
+         */
+        bool Exists(const std::string& identifier);
         /**
          * Lädt ein Bild aus den Suchordnern. Das Image muss vom Caller entladen werden.
          */
-        Image LoadRawImage(std::string identifier);
+        Image LoadRawImage(const std::string& identifier);
         /**
          * Erstellt eine Textur aus einem Bild. Kann verwendet werden, um über LoadRawImage() ein Bild zu laden, es zu verändern, und dann als Textur hochzuladen.
          */
-        Texture2D UploadCustomTexture(std::string identifier, Image image);
+        Texture2D UploadCustomTexture(const std::string& identifier, Image image);
         /**
          * Liest eine Datei ein und gibt das Ergebnis als String zurück.
          */
-        std::optional<std::string> ReadResourceFile(std::string identifier);
+        std::optional<std::string> ReadResourceFile(const std::string& identifier);
         /**
-         * Lädt eine Animation und gibt einen Zeiger zu dieser zurück.
-         * Alle Animationen werden innerhalb des AssetManagers gespeichert; Interaktion erfolgt nur über Zeiger damit der State der Animationen konsistent bleibt.
+         * Lädt eine Animation und gibt ein Handle auf sie zurück; weitere Aufrufe mit derselben id liefern dasselbe Handle ohne erneutes Laden.
+         * Alle Animationen werden innerhalb des AssetManagers gespeichert; Interaktion erfolgt nur über Handles, damit der State der Animationen konsistent bleibt.
          */
-        std::optional<Animation*> GetAnimation(std::string identifier);
+        std::optional<AnimationHandle> GetAnimation(AssetId id);
+        std::optional<AnimationHandle> GetAnimation(const std::string& identifier);
+        /**
+         * Löst ein Handle aus GetAnimation() auf, egal von welchem AssetManager es stammt. Gibt nullptr zurück, wenn die Animation mit ihrem AssetManager
+         * entladen wurde. Der Zeiger ist nur bis zum nächsten Laden oder Entladen einer Animation gültig, das Handle dagegen dauerhaft.
+         */
+        static Animation *ResolveAnimation(AnimationHandle handle);
+        /**
+         * Mountet ein .swpak Archiv für alle AssetManager. Ein Pfad wie mountPoint + "font/A.png" wird dann aus dem Eintrag "font/A.png" des Archivs gelesen, ohne das Dateisystem anzufassen.
+         * Jedes Archiv wird nur einmal geöffnet und gemappt.
+         */
+        static bool MountArchive(const std::string& archivePath, const std::string& mountPoint);
+        static ArchiveLookup FindInArchives(const std::string& path);
+        /**
+         * Startet das Laden einer Textur im Hintergrund. Ist die Textur schon geladen, ist das Handle sofort fertig.
+         * Mehrfache Anfragen für denselben Identifier teilen sich ein Handle. Das Asset wird nicht gepinnt: ist das letzte Request weg, darf es wie bei AcquireTexture() verdrängt werden.
+         */
+        TextureRequest RequestTexture(AssetId id);
+        TextureRequest RequestTexture(const std::string& identifier);
+        /**
+         * Startet das Laden eines Sounds im Hintergrund, siehe RequestTexture().
+         */
+        SoundRequest RequestSound(AssetId id);
+        SoundRequest RequestSound(const std::string& identifier);
+        /**
+         * Legt den Atlas fest, in den RequestAtlasSprite() lädt. Ohne eigenen Atlas wird der des Parents benutzt. Ownership bleibt beim Caller.
+         */
+        void SetAtlas(TextureAtlas *atlas);
+        /**
+         * Startet das Laden eines Bildes in den Atlas im Hintergrund, siehe RequestTexture(). Dekodiert wird auf dem Threadpool,
+         * gepackt und hochgeladen in ProcessUploads(); alle Bilder eines Aufrufs teilen sich dabei einen Upload pro Atlasseite.
+         */
+        AtlasSpriteRequest RequestAtlasSprite(AssetId id);
+        AtlasSpriteRequest RequestAtlasSprite(const std::string& identifier);
+        /**
+         * Lädt höchstens maxUploads im Hintergrund dekodierte Assets auf die GPU bzw. in den Audiospeicher und macht ihre Handles fertig.
+         * Muss einmal pro Frame auf dem Main-Thread aufgerufen werden, außerhalb von BeginDrawing()/EndDrawing(). Gibt die Anzahl der hochgeladenen Assets zurück.
+         * Verdrängt nichts und darf deshalb auch mitten im Frame laufen, z.B. aus AssetRequest::Wait().
+         */
+        static size_t ProcessUploads(size_t maxUploads);
+        /**
+         * Verdrängt in allen AssetManagern nicht mehr referenzierte Assets, bis ihre Budgets wieder passen.
+         * Nur an der Framegrenze nach EndDrawing() aufrufen, wenn kein Rohwert aus diesem Frame mehr gezeichnet oder abgespielt wird.
+         */
+        static void TrimCaches();
+        /**
+         * Wird bei jedem Hot Reload einer Textur oder Animation erhöht. Wer Texturen oder Animationsparameter als Rohwert zwischenspeichert (z.B. der FontRenderer), verwirft seinen Cache, wenn sich der Wert ändert.
+         */
+        static uint64_t GetReloadGeneration();
     private:
-        std::optional<Texture2D> _GetTexture(std::string identifier);
-        std::optional<Sound> _GetSound(std::string identifier);
+        struct CandidateSource {
+            std::shared_ptr<AssetManager*> owner;
+            std::vector<std::string> paths;
+        };
+        /**
+         * Lädt das Asset falls nötig und gibt den Cache zurück, in dem es liegt (kann der eines Parents sein), oder nullptr.
+         */
+        TextureCache *_GetTexture(AssetId id);
+        SoundCache *_GetSound(AssetId id);
+        TextureCache *FindLoadedTexture(AssetId id);
+        SoundCache *FindLoadedSound(AssetId id);
+        TextureAtlas *GetAtlas();
+        /**
+         * Die aufgelösten Pfade der Kette von der Wurzel bis zu diesem AssetManager, in derselben Reihenfolge in der auch synchron gesucht wird.
+         */
+        std::vector<CandidateSource> CollectCandidates(AssetId id);
+        struct SearchDir {
+            std::string path;
+            //false für Ordner, die von einem Archiv abgedeckt werden; dort wird direkt im Archivindex gesucht
+            bool indexed = false;
+            //relative Pfade aller Dateien unterhalb von path
+            std::unordered_set<std::string> files;
+        };
+        struct ResolvedPath {
+            bool found;
+            std::string path;
+        };
+        /**
+         * Sucht identifier im Identifier selbst und dann in allen Suchordnern dieses AssetManagers (ohne Parent). Treffer und Fehlschläge werden gecached.
+         */
+        std::optional<std::string> ResolvePath(AssetId id);
+        bool CandidateExists(const std::string& path, const SearchDir *dir, const std::string& identifier) const;
+        void IndexSearchDir(SearchDir& dir);
+        void ProcessFileEvents();
+        /**
+         * Dekodiert ein geändertes Asset auf dem Threadpool neu; ApplyReload() tauscht es danach in ProcessUploads() aus.
+         */
+        void QueueReload(AssetId id);
+        void ApplyReload(PendingUpload& upload);
+        //Hintergrundjobs halten nur dieses Handle; der Destruktor setzt es auf nullptr, damit fertige Uploads nicht in einen toten AssetManager schreiben
+        std::shared_ptr<AssetManager*> self{std::make_shared<AssetManager*>(this)};
+        AssetSlots<TextureRequest> pendingTextures;
+        AssetSlots<SoundRequest> pendingSounds;
+        AssetSlots<AtlasSpriteRequest> pendingSprites;
+        TextureAtlas *atlas = nullptr;
         AssetManager *parent = nullptr;
-        std::vector<std::string> searchDirs;
-        std::unordered_map<std::string, Texture2D> loadedTextures;
-        std::unordered_map<std::string, Sound> loadedSounds;
-        std::unordered_map<std::string, Animation*> loadedAnimations;
-        ArenaAllocator<sizeof(Animation)*64> animationAllocator;
+        std::vector<SearchDir> searchDirs;
+        AssetSlots<ResolvedPath> resolvedPaths;
+        std::unique_ptr<FileWatcher> watcher;
+        TextureCache loadedTextures{DEFAULT_TEXTURE_BUDGET_BYTES};
+        SoundCache loadedSounds{DEFAULT_SOUND_BUDGET_BYTES};
+        AssetSlots<AnimationHandle> loadedAnimations;
     };
 
+template<typename T>
+std::optional<T> AssetRequest<T>::Wait() const {
+
+    if (data == nullptr) {
+        return std::nullopt;
+    }
+
+    while (data->state.load(std::memory_order_acquire) == AssetRequestState::LOADING) {
+
+        if (AssetManager::ProcessUploads(SIZE_MAX) == 0) {
+            std::this_thread::yield();
+        }
+
+    }
+
+    return Get();
+
+}
+
+struct TextLayoutGlyph {
+    Texture2D texture;
+    Rectangle source;
+    //relativ zu der Position, an der das Layout gezeichnet wird
+    Rectangle dest;
+};
+
+/**
+ * Fertig gesetzter Text: die Quads aller Buchstaben und die Gesamtgröße. Einmal bauen und beliebig oft (auch an verschiedenen Positionen) zeichnen.
+ * Nach einem Hot Reload der Schrift kann ein gespeichertes Layout veraltete Sprites enthalten und sollte neu gebaut werden.
+ */
+struct TextLayout {
+    std::vector<TextLayoutGlyph> glyphs;
+    Vector2 size{0, 0};
+};
+
+/**
+ * Zeichnet Text aus einzelnen Buchstabenbildern. Alle Buchstaben liegen in einem TextureAtlas, ein String wird also ohne Texturwechsel gezeichnet.
+ * Strings sind UTF-8; gezeichnet werden kann alles aus Latin-1, für das die Schrift ein Bild hat (Umlaute und ß eingeschlossen).
+ *
+ * Die String-Funktionen benutzen einen kleinen LRU-Cache von Layouts, Schlüssel ist (String, Scale Faktor). Wer jeden Frame denselben Text
+ * misst und zeichnet, setzt ihn also nur einmal. Für Text, der sich selten ändert, kann man sich das Layout mit Layout() auch selbst merken.
+ */
 class FontRenderer {
     public:
-        FontRenderer(std::string fontDir);
+        /**
+         * Ownership des Atlas bleibt beim Caller; er muss den FontRenderer überleben.
+         */
+        FontRenderer(std::string fontDir, TextureAtlas *atlas);
         ~FontRenderer() = default;
+        /**
+         * Setzt einen String, eventuell mit Scale Faktor. Geht nicht über den Cache.
+         */
+        TextLayout Layout(std::string_view str, float scaleFactor = 1.0f);
+        /**
+         * Zeichnet ein Layout mit einem Draw Call (bzw. in den gesetzten SpriteBatch).
+         */
+        void DrawLayout(const TextLayout& layout, Vector2 position, Color tint = WHITE);
         /**
          * Zeichnet einen String, eventuell mit Scale Faktor.
          */
-        void DrawString(std::string str, Vector2 position, float scaleFactor = 1.0f);
+        void DrawString(std::string_view str, Vector2 position, float scaleFactor = 1.0f);
         /**
          * Gibt Höhe und Breite dieses Strings zurück, eventuell unter Berücksichtigung eines Scale Faktors.
          */
-        Vector2 MeasureString(std::string str, float scaleFactor = 1.0f);
+        Vector2 MeasureString(std::string_view str, float scaleFactor = 1.0f);
+        /**
+         * Zeichnet einen String und gibt dann die x-Koordinate seines Endes und seine Höhe, eventuell unter Berücksichtigung eines Scale Faktors, zurück.
+         */
+        Vector2 DrawStringAndMeasure(std::string_view str, Vector2 position, float scaleFactor = 1.0f);
         /**
-         * Zeichnet einen String und gibt dann Höhe und Breite, eventuell unter Berücksichtigung eines Scale Faktors, zurück.
+         * Solange ein Batch gesetzt ist, reihen die Draw-Funktionen ihre Buchstaben nur dort ein; gezeichnet wird beim Flush() des Callers.
+         * Mit nullptr (Standard) wird jeder String sofort gezeichnet, mit einem Draw Call pro String. Ownership bleibt beim Caller.
          */
-        Vector2 DrawStringAndMeasure(std::string str, Vector2 position, float scaleFactor = 1.0f);
+        void SetSpriteBatch(SpriteBatch *batch);
+        static constexpr inline size_t LAYOUT_CACHE_CAPACITY = 128;
     private:
-        Texture2D GetCharTexture(char c);
+        /**
+         * Füllt die Buchstabentabelle: alle Bilder der Schrift werden gemeinsam angefragt und in einem Rutsch in den Atlas geladen.
+         * Läuft beim ersten Setzen von Text (vorher gibt es evtl. noch keinen OpenGL-Kontext) und nach einem Hot Reload.
+         */
+        void LoadGlyphs();
+        const TextLayout& GetCachedLayout(std::string_view str, float scaleFactor);
+        /**
+         * Verwirft Buchstaben und Layouts, wenn seit dem letzten Aufruf ein Asset neu geladen wurde.
+         */
+        void CheckReloadGeneration();
+        struct CachedLayout {
+            std::string text;
+            float scaleFactor;
+            TextLayout layout;
+        };
+        //zeigt in den String des Listeneintrags, der sich nicht bewegt, solange der Eintrag lebt
+        struct LayoutKey {
+            std::string_view text;
+            float scaleFactor;
+            bool operator==(const LayoutKey& other) const = default;
+        };
+        struct LayoutKeyHash {
+            size_t operator()(const LayoutKey& key) const;
+        };
         AssetManager fontAssetManager;
-        std::unordered_map<char, Texture2D> cachedTextures;
+        //Latin-1 deckt ASCII und die Umlaute ab; pro Buchstabe ist das Sprite ein einziger Arrayzugriff. Fehlende Buchstaben haben Textur-ID 0.
+        static constexpr inline size_t GLYPH_TABLE_SIZE = 256;
+        std::array<AtlasSprite, GLYPH_TABLE_SIZE> glyphs{};
+        std::bitset<GLYPH_TABLE_SIZE> reportedMissing;
+        //Codepoints jenseits der Tabelle (z.B. Emoji) können nie gezeichnet werden und würden sonst bei jedem neuen Layout erneut gemeldet
+        std::unordered_set<char32_t> reportedMissingOutsideTable;
+        bool glyphsLoaded = false;
+        //vorne der zuletzt benutzte Eintrag
+        std::list<CachedLayout> layoutLru;
+        std::unordered_map<LayoutKey, std::list<CachedLayout>::iterator, LayoutKeyHash> layoutIndex;
+        SpriteBatch *batch = nullptr;
+        SpriteBatch ownBatch;
+        uint64_t cachedGeneration = 0;
         static constexpr inline float spaceWidth = 16;
 };
 
-struct SoundQueueEntry {
-    bool isSilence;
-    int silenceMillis;
-    Sound sound;
-    bool looping;
-    bool fadeIn;
-    int fadeInMillis;
-};
-
-enum class SoundQueueState {
-
-    EMPTY,
-    SILENCE,
-    PLAYING,
-    FADING_IN,
-    FADING_OUT
-
-};
-
-class SoundQueue {
-    public:
-        SoundQueue();
-        ~SoundQueue() = default;
-        void QueueSilence(int silenceMillis);
-        void Queue(Sound sound);
-        void QueueFadeIn(Sound sound, int fadeInMillis);
-        void QueueLooping(Sound sound);
-        void QueueLoopingFadeIn(Sound sound, int fadeInMillis);
-        void SkipToNext();
-        void FadeOutAndSkipToNext(int fadeOutMillis);
-        void Update();
-        bool IsEmpty();
-        void Clear();
-    private:
-        void BeginPlaying();
-        std::queue<SoundQueueEntry> queuedSounds;
-        SoundQueueState state = SoundQueueState::EMPTY;
-        int fadeMillis = -1;
-        TickTimer silenceTimer;
-        TickTimer fadeTimer;
-};
-
 using Dictionary = std::unordered_map<std::string, std::string>;
 
-Dictionary ParseDictionary(std::string stringToParse, std::string entryDelimiter, std::string keyValueDelimiter);
+Dictionary ParseDictionary(const std::string& stringToParse, const std::string& entryDelimiter, const std::string& keyValueDelimiter);
 
 bool IsPositiveInt(const std::string& str);
 
-std::vector<int> ParsePositiveIntList(std::string stringToParse, std::string delimiter);
+std::vector<int> ParsePositiveIntList(const std::string& stringToParse, const std::string& delimiter);
 
-std::vector<unsigned char> Base64Decode(const std::string& in);
+/**
+ * Dekodiert den UTF-8 Codepoint, der bei index beginnt, und setzt index auf den nächsten. Ungültige Bytes ergeben U+FFFD und werden einzeln übersprungen.
+ */
+char32_t DecodeUtf8(std::string_view str, size_t& index);
 
-Texture2D BuildSpriteAtlas(const std::vector<Texture2D>& textures, std::vector<Rectangle> *frameInfoOutput);
\ No newline at end of file
+std::vector<unsigned char> Base64Decode(const std::string& in);
@@ -0,0 +1,403 @@
+#include "atlas.h"
+
+#include "../io/debug.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+/**
+ * SkylinePacker class
+ */
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+
+    Reset();
+
+}
+
+void SkylinePacker::Reset() {
+
+    skyline.clear();
+    skyline.push_back({0, 0, width});
+
+}
+
+int SkylinePacker::GetWidth() const {
+
+    return width;
+
+}
+
+int SkylinePacker::GetHeight() const {
+
+    return height;
+
+}
+
+int SkylinePacker::GetUsedHeight() const {
+
+    int used = 0;
+    for (const Segment& segment : skyline) {
+        used = std::max(used, segment.y);
+    }
+    return used;
+
+}
+
+int SkylinePacker::FitAt(size_t index, int rectWidth, int rectHeight) const {
+
+    if (skyline[index].x + rectWidth > width) {
+        return -1;
+    }
+
+    //das Rechteck liegt auf dem höchsten Segment, das es überdeckt
+    int y = 0;
+    int remaining = rectWidth;
+
+    for (size_t i = index; remaining > 0; ++i) {
+
+        y = std::max(y, skyline[i].y);
+        if (y + rectHeight > height) {
+            return -1;
+        }
+        remaining -= skyline[i].width;
+
+    }
+
+    return y;
+
+}
+
+std::optional<PackedRect> SkylinePacker::Insert(int rectWidth, int rectHeight) {
+
+    if (rectWidth <= 0 || rectHeight <= 0) {
+        return PackedRect{0, 0, std::max(rectWidth, 0), std::max(rectHeight, 0)};
+    }
+
+    size_t bestIndex = SIZE_MAX;
+    int bestTop = INT_MAX;
+    int bestSegmentWidth = INT_MAX;
+    int bestY = 0;
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+
+        const int y = FitAt(i, rectWidth, rectHeight);
+        if (y < 0) {
+            continue;
+        }
+
+        //niedrigste Oberkante gewinnt, bei Gleichstand das schmalere Segment, damit breite Lücken für breite Rechtecke frei bleiben
+        const int top = y + rectHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestSegmentWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestSegmentWidth = skyline[i].width;
+            bestY = y;
+        }
+
+    }
+
+    if (bestIndex == SIZE_MAX) {
+        return std::nullopt;
+    }
+
+    const PackedRect rect{skyline[bestIndex].x, bestY, rectWidth, rectHeight};
+
+    skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), {rect.x, rect.y + rect.height, rect.width});
+
+    //Segmente, die jetzt unter dem neuen Rechteck liegen, kürzen oder entfernen
+    for (size_t i = bestIndex + 1; i < skyline.size();) {
+
+        const Segment& previous = skyline[i - 1];
+        Segment& segment = skyline[i];
+
+        const int overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0) {
+            break;
+        }
+
+        segment.x += overlap;
+        segment.width -= overlap;
+
+        if (segment.width > 0) {
+            break;
+        }
+        skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+
+    }
+
+    //benachbarte Segmente auf gleicher Höhe zusammenfassen
+    for (size_t i = 0; i + 1 < skyline.size();) {
+
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+
+    }
+
+    return rect;
+
+}
+
+/**
+ * Atlasseiten
+ */
+
+void BlitImage(Image& dst, const Image& src, int x, int y) {
+
+    if (dst.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || x < 0 || y < 0 || x + src.width > dst.width || y + src.height > dst.height) {
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot blit a %ix%i image to (%i, %i) of a %ix%i atlas.", src.width, src.height, x, y, dst.width, dst.height);
+        return;
+    }
+
+    Image converted{};
+    const Image *pixels = &src;
+
+    if (src.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        converted = ImageCopy(src);
+        ImageFormat(&converted, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        pixels = &converted;
+    }
+
+    constexpr size_t BYTES_PER_PIXEL = 4;
+    const size_t rowBytes = static_cast<size_t>(src.width) * BYTES_PER_PIXEL;
+    const unsigned char *from = static_cast<const unsigned char*>(pixels->data);
+    unsigned char *to = static_cast<unsigned char*>(dst.data);
+
+    for (int row = 0; row < src.height; ++row) {
+
+        const size_t dstOffset = (static_cast<size_t>(y + row) * dst.width + x) * BYTES_PER_PIXEL;
+        std::memcpy(to + dstOffset, from + row * rowBytes, rowBytes);
+
+    }
+
+    if (converted.data != nullptr) {
+        UnloadImage(converted);
+    }
+
+}
+
+AtlasBuilder::AtlasBuilder(int pageSize, int padding) : pageSize(pageSize), padding(padding) {}
+
+AtlasBuilder::~AtlasBuilder() {
+
+    for (const Image& page : pages) {
+        UnloadImage(page);
+    }
+
+}
+
+AtlasRegion AtlasBuilder::Place(size_t page, PackedRect rect, const Image& image) {
+
+    BlitImage(pages[page], image, rect.x, rect.y);
+
+    const float pageWidth = static_cast<float>(pages[page].width);
+    const float pageHeight = static_cast<float>(pages[page].height);
+
+    AtlasRegion region;
+    region.page = static_cast<int>(page);
+    region.source = {static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(image.width), static_cast<float>(image.height)};
+    region.uv = {region.source.x / pageWidth, region.source.y / pageHeight, region.source.width / pageWidth, region.source.height / pageHeight};
+
+    return region;
+
+}
+
+AtlasRegion AtlasBuilder::Add(const Image& image) {
+
+    //zu groß für eine normale Seite: eigene Seite, die genau passt
+    if (image.width > pageSize || image.height > pageSize) {
+
+        pages.push_back(GenImageColor(image.width, image.height, BLANK));
+        packers.emplace_back(image.width, image.height);
+
+        return Place(pages.size() - 1, packers.back().Insert(image.width, image.height).value(), image);
+
+    }
+
+    //der Packer ist um padding größer als die Seite, damit ein Bild bis an den Rand reichen darf; der Abstand liegt dann außerhalb der Seite
+    for (size_t page = 0; page < pages.size(); ++page) {
+
+        if (packers[page].GetWidth() != pageSize + padding) {
+            continue;
+        }
+
+        if (const std::optional<PackedRect> rect = packers[page].Insert(image.width + padding, image.height + padding)) {
+            return Place(page, rect.value(), image);
+        }
+
+    }
+
+    pages.push_back(GenImageColor(pageSize, pageSize, BLANK));
+    packers.emplace_back(pageSize + padding, pageSize + padding);
+
+    return Place(pages.size() - 1, packers.back().Insert(image.width + padding, image.height + padding).value(), image);
+
+}
+
+std::vector<AtlasRegion> AtlasBuilder::AddAll(std::span<const Image> images) {
+
+    std::vector<size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+        if (images[a].height != images[b].height) {
+            return images[a].height > images[b].height;
+        }
+        return images[a].width > images[b].width;
+    });
+
+    std::vector<AtlasRegion> regions(images.size());
+    for (const size_t index : order) {
+        regions[index] = Add(images[index]);
+    }
+
+    return regions;
+
+}
+
+void AtlasBuilder::Overwrite(const AtlasRegion& region, const Image& image) {
+
+    if (region.page < 0 || static_cast<size_t>(region.page) >= pages.size()
+        || image.width != static_cast<int>(region.source.width) || image.height != static_cast<int>(region.source.height)) {
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot overwrite atlas region with an image of a different size.");
+        return;
+    }
+
+    BlitImage(pages[region.page], image, static_cast<int>(region.source.x), static_cast<int>(region.source.y));
+
+}
+
+const std::vector<Image>& AtlasBuilder::GetPages() const {
+
+    return pages;
+
+}
+
+std::vector<Image> AtlasBuilder::ReleasePages() {
+
+    packers.clear();
+    return std::exchange(pages, {});
+
+}
+
+/**
+ * TextureAtlas class
+ */
+
+TextureAtlas::TextureAtlas(int pageSize, int padding) : builder(pageSize, padding) {}
+
+TextureAtlas::~TextureAtlas() {
+
+    *self = nullptr;
+
+    for (const Texture2D& texture : pageTextures) {
+        if (texture.id != 0) {
+            UnloadTexture(texture);
+        }
+    }
+
+}
+
+std::optional<AtlasSprite> TextureAtlas::Find(AssetId id) const {
+
+    const Entry *entry = entries.Find(id);
+    if (entry == nullptr || !entry->committed) {
+        return std::nullopt;
+    }
+
+    return AtlasSprite{pageTextures[entry->region.page], entry->region.source, entry->region.uv};
+
+}
+
+bool TextureAtlas::Contains(AssetId id) const {
+
+    return entries.Contains(id);
+
+}
+
+void TextureAtlas::Add(AssetId id, const Image& image) {
+
+    if (entries.Contains(id)) {
+        return;
+    }
+
+    const AtlasRegion region = builder.Add(image);
+    entries.Set(id, Entry{region, false});
+    staged.push_back(id);
+
+    dirtyPages.resize(builder.GetPages().size(), false);
+    dirtyPages[region.page] = true;
+
+}
+
+bool TextureAtlas::Replace(AssetId id, const Image& image) {
+
+    Entry *entry = entries.Find(id);
+    if (entry == nullptr) {
+        Add(id, image);
+        return false;
+    }
+
+    if (image.width == static_cast<int>(entry->region.source.width) && image.height == static_cast<int>(entry->region.source.height)) {
+        builder.Overwrite(entry->region, image);
+        dirtyPages[entry->region.page] = true;
+        return false;
+    }
+
+    entry->region = builder.Add(image);
+    entry->committed = false;
+    staged.push_back(id);
+
+    dirtyPages.resize(builder.GetPages().size(), false);
+    dirtyPages[entry->region.page] = true;
+
+    return true;
+
+}
+
+void TextureAtlas::Commit() {
+
+    const std::vector<Image>& pages = builder.GetPages();
+    pageTextures.resize(pages.size(), Texture2D{});
+
+    for (size_t page = 0; page < dirtyPages.size(); ++page) {
+
+        if (!dirtyPages[page]) {
+            continue;
+        }
+
+        //gleiche Größe, gleiches Format: die Textur wird an Ort und Stelle aktualisiert, alle Kopien ihres Rohwerts bleiben gültig
+        if (pageTextures[page].id == 0) {
+            pageTextures[page] = LoadTextureFromImage(pages[page]);
+        } else {
+            UpdateTexture(pageTextures[page], pages[page].data);
+        }
+        dirtyPages[page] = false;
+
+    }
+
+    for (const AssetId id : staged) {
+        entries.Find(id)->committed = true;
+    }
+    staged.clear();
+
+}
+
+size_t TextureAtlas::GetPageCount() const {
+
+    return builder.GetPages().size();
+
+}
+
+const std::shared_ptr<TextureAtlas*>& TextureAtlas::GetSelf() const {
+
+    return self;
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include "assetid.h"
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * Position eines gepackten Rechtecks in Pixeln.
+ */
+struct PackedRect {
+    int x, y;
+    int width, height;
+};
+
+/**
+ * Rechteckpacker nach dem Skyline-Bottom-Left-Verfahren. Die belegte Fläche wird als Folge horizontaler Segmente (die "Skyline") gespeichert;
+ * ein neues Rechteck landet dort, wo seine Oberkante am niedrigsten liegt. Reine CPU-Logik ohne raylib-Aufrufe.
+ */
+class SkylinePacker final {
+    public:
+        SkylinePacker(int width, int height);
+        /**
+         * Sucht Platz für ein Rechteck und belegt ihn. Gibt std::nullopt zurück, wenn es nicht mehr passt.
+         */
+        std::optional<PackedRect> Insert(int width, int height);
+        void Reset();
+        int GetWidth() const;
+        int GetHeight() const;
+        /**
+         * Höchster belegter Punkt, d.h. die Höhe, auf die eine Seite ohne Verlust zugeschnitten werden kann.
+         */
+        int GetUsedHeight() const;
+    private:
+        struct Segment {
+            int x, y;
+            int width;
+        };
+        /**
+         * Die y-Position, an der ein Rechteck der Breite width ab Segment index liegen würde, oder -1 wenn es dort nicht passt.
+         */
+        int FitAt(size_t index, int width, int height) const;
+        int width, height;
+        std::vector<Segment> skyline;
+};
+
+/**
+ * Wo ein Teilbild in einem Atlas liegt: Seite, Quellrechteck in Pixeln und dasselbe Rechteck in normierten Texturkoordinaten (0..1).
+ */
+struct AtlasRegion {
+    int page = -1;
+    Rectangle source{};
+    Rectangle uv{};
+};
+
+/**
+ * Kopiert src pixelgenau (ohne Blending) nach dst an Position (x, y). dst muss RGBA8 sein, src wird bei Bedarf konvertiert.
+ */
+void BlitImage(Image& dst, const Image& src, int x, int y);
+
+/**
+ * Baut Atlasseiten im Hauptspeicher, ganz ohne GPU. Bilder beliebiger Größe werden auf Seiten von pageSize x pageSize gepackt,
+ * bei Bedarf wird eine neue Seite angefangen. Ein Bild, das größer als eine Seite ist, bekommt eine eigene Seite in seiner Größe.
+ * Zwischen den Bildern bleibt ein transparenter Rand von padding Pixeln, damit beim Filtern nichts vom Nachbarn hineinblutet.
+ */
+class AtlasBuilder final {
+    public:
+        AtlasBuilder(int pageSize, int padding);
+        ~AtlasBuilder();
+        AtlasBuilder(const AtlasBuilder&) = delete;
+        AtlasBuilder& operator=(const AtlasBuilder&) = delete;
+        /**
+         * Packt ein Bild und kopiert seine Pixel auf die gewählte Seite. Das Bild bleibt beim Caller.
+         */
+        AtlasRegion Add(const Image& image);
+        /**
+         * Packt mehrere Bilder auf einmal, nach Höhe sortiert, was deutlich dichter packt als einzeln in Ankunftsreihenfolge.
+         * Die Regionen stehen in derselben Reihenfolge wie images.
+         */
+        std::vector<AtlasRegion> AddAll(std::span<const Image> images);
+        /**
+         * Überschreibt die Pixel einer Region, image muss genau so groß sein wie die Region.
+         */
+        void Overwrite(const AtlasRegion& region, const Image& image);
+        const std::vector<Image>& GetPages() const;
+        /**
+         * Gibt die Seiten an den Caller ab (der sie mit UnloadImage() freigeben muss) und beginnt von vorne.
+         */
+        std::vector<Image> ReleasePages();
+    private:
+        AtlasRegion Place(size_t page, PackedRect rect, const Image& image);
+        int pageSize;
+        int padding;
+        std::vector<Image> pages;
+        //ein Packer pro Seite, parallel zu pages
+        std::vector<SkylinePacker> packers;
+};
+
+/**
+ * Ein Bild in einem TextureAtlas: die Seitentextur und wo in ihr das Bild liegt. Zum Zeichnen texture mit source als Quellrechteck benutzen.
+ */
+struct AtlasSprite {
+    Texture2D texture{};
+    Rectangle source{};
+    Rectangle uv{};
+};
+
+inline constexpr int DEFAULT_ATLAS_PAGE_SIZE = 1024;
+
+/**
+ * Gemeinsamer Laufzeitatlas für kleine Bilder (Schriftzeichen, Menügrafiken, ...). Bilder werden mit Add() auf der CPU gepackt und
+ * mit Commit() gesammelt hochgeladen, pro geänderter Seite ein Upload. Alles, was auf denselben Seiten liegt, kann ohne Texturwechsel gezeichnet werden.
+ *
+ * Nur auf dem Main-Thread benutzen. Seitentexturen bleiben bis zur Zerstörung des Atlas gültig; ihre IDs ändern sich auch bei Commit() nicht.
+ */
+class TextureAtlas final {
+    public:
+        explicit TextureAtlas(int pageSize = DEFAULT_ATLAS_PAGE_SIZE, int padding = 1);
+        ~TextureAtlas();
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+        /**
+         * Gibt das Sprite zu id zurück, oder std::nullopt wenn id nicht im Atlas liegt oder noch nicht committed wurde.
+         */
+        std::optional<AtlasSprite> Find(AssetId id) const;
+        bool Contains(AssetId id) const;
+        /**
+         * Packt ein Bild unter id in den Atlas. Liegt id schon im Atlas, passiert nichts. Sichtbar wird das Bild erst nach Commit().
+         */
+        void Add(AssetId id, const Image& image);
+        /**
+         * Ersetzt das Bild zu id (z.B. beim Hot Reload). Hat es dieselbe Größe, werden nur die Pixel überschrieben und alle Sprites bleiben gültig.
+         * Sonst wird es neu gepackt (der alte Platz bleibt ungenutzt) und die Funktion gibt true zurück: zwischengespeicherte Sprites sind dann veraltet.
+         */
+        bool Replace(AssetId id, const Image& image);
+        /**
+         * Lädt alle seit dem letzten Commit() geänderten Seiten auf die GPU.
+         */
+        void Commit();
+        size_t GetPageCount() const;
+        /**
+         * Handle für Hintergrundjobs, siehe AssetManager::self. Zeigt auf nullptr, sobald der Atlas zerstört ist.
+         */
+        const std::shared_ptr<TextureAtlas*>& GetSelf() const;
+    private:
+        struct Entry {
+            AtlasRegion region;
+            bool committed;
+        };
+        AtlasBuilder builder;
+        std::vector<Texture2D> pageTextures;
+        std::vector<bool> dirtyPages;
+        AssetSlots<Entry> entries;
+        //seit dem letzten Commit() hinzugefügt
+        std::vector<AssetId> staged;
+        std::shared_ptr<TextureAtlas*> self{std::make_shared<TextureAtlas*>(this)};
+};
@@ -0,0 +1,662 @@
+#include "mixer.h"
+
+#include "../io/debug.h"
+#include "../io/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * AudioMixer class
+ */
+
+AudioMixer::AudioMixer(unsigned int sampleRate) : sampleRate(sampleRate) {}
+
+bool AudioMixer::Post(const MixerCommand& command) {
+
+    return commands.Write(&command, 1) == 1;
+
+}
+
+bool AudioMixer::PopRetired(MusicStream *& stream) {
+
+    return retired.Read(&stream, 1) == 1;
+
+}
+
+unsigned int AudioMixer::GetSampleRate() const {
+
+    return sampleRate;
+
+}
+
+SoundQueueState AudioMixer::GetState() const {
+
+    return publishedState.load(std::memory_order_relaxed);
+
+}
+
+const MixerEntry& AudioMixer::Front() const {
+
+    return entries[entryHead];
+
+}
+
+void AudioMixer::Retire(MusicStream *stream) {
+
+    //kann nicht überlaufen: die SoundQueue lässt höchstens MAX_ENTRIES Einträge gleichzeitig unterwegs sein
+    retired.Write(&stream, 1);
+
+}
+
+void AudioMixer::ApplyCommands() {
+
+    MixerCommand command;
+    while (commands.Read(&command, 1) == 1) {
+
+        switch (command.type) {
+            case MixerCommand::Type::QUEUE:
+                Enqueue(command.entry);
+                break;
+            case MixerCommand::Type::SKIP:
+                Skip(command.fadeOutFrames);
+                break;
+            case MixerCommand::Type::CLEAR:
+                Clear();
+                break;
+        }
+
+    }
+
+}
+
+void AudioMixer::Enqueue(const MixerEntry& entry) {
+
+    if (entryCount == MAX_ENTRIES) {
+        Retire(entry.stream);
+        return;
+    }
+
+    entries[(entryHead + entryCount) % MAX_ENTRIES] = entry;
+    ++entryCount;
+
+    if (entryCount == 1) {
+        BeginFront();
+    }
+
+}
+
+void AudioMixer::BeginFront() {
+
+    if (entryCount == 0) {
+        state = SoundQueueState::EMPTY;
+        return;
+    }
+
+    const MixerEntry& entry = Front();
+
+    if (entry.stream == nullptr) {
+        state = SoundQueueState::SILENCE;
+        silenceRemaining = entry.silenceFrames;
+        return;
+    }
+
+    StartVoice(current, entry.stream, entry.looping);
+
+    if (entry.fadeInFrames > 0) {
+        current.gain = 0;
+        Ramp(current, 1, entry.fadeInFrames, false);
+        state = SoundQueueState::FADING_IN;
+    } else {
+        state = SoundQueueState::PLAYING;
+    }
+
+}
+
+void AudioMixer::PopFront(bool keepVoice) {
+
+    const MixerEntry entry = Front();
+    entryHead = (entryHead + 1) % MAX_ENTRIES;
+    --entryCount;
+
+    if (entry.stream == nullptr) {
+        Retire(nullptr);
+        return;
+    }
+
+    if (!keepVoice) {
+        StopVoice(current);
+        return;
+    }
+
+    //höchstens ein Eintrag wird gleichzeitig ausgeblendet; ein noch laufender bricht ab
+    StopVoice(outgoing);
+    outgoing = current;
+    current.stream = nullptr;
+
+}
+
+void AudioMixer::BeginCrossfade(uint32_t frames) {
+
+    PopFront(true);
+    Ramp(outgoing, 0, frames, true);
+
+    BeginFront();
+    if (current.stream != nullptr) {
+        current.gain = 0;
+        Ramp(current, 1, frames, false);
+        state = SoundQueueState::FADING_IN;
+    }
+
+}
+
+void AudioMixer::Skip(uint32_t fadeOutFrames) {
+
+    if (entryCount == 0) {
+        return;
+    }
+
+    if (Front().stream == nullptr) {
+        PopFront(false);
+        BeginFront();
+        return;
+    }
+
+    //will der nächste Eintrag überblenden, hat das Vorrang vor einem einfachen Ausblenden
+    if (entryCount > 1) {
+        const MixerEntry& next = entries[(entryHead + 1) % MAX_ENTRIES];
+        if (next.stream != nullptr && next.crossfadeFrames > 0) {
+            BeginCrossfade(next.crossfadeFrames);
+            return;
+        }
+    }
+
+    if (fadeOutFrames == 0) {
+        PopFront(false);
+        BeginFront();
+        return;
+    }
+
+    Ramp(current, 0, fadeOutFrames, true);
+    state = SoundQueueState::FADING_OUT;
+
+}
+
+void AudioMixer::Clear() {
+
+    StopVoice(outgoing);
+    //der Stream der aktuellen Stimme ist der des vordersten Eintrags und wird mit den Einträgen zurückgemeldet
+    current.stream = nullptr;
+
+    while (entryCount > 0) {
+        Retire(Front().stream);
+        entryHead = (entryHead + 1) % MAX_ENTRIES;
+        --entryCount;
+    }
+
+    state = SoundQueueState::EMPTY;
+
+}
+
+void AudioMixer::StartVoice(Voice& voice, MusicStream *stream, bool looping) {
+
+    voice.stream = stream;
+    voice.looping = looping;
+    voice.step = static_cast<double>(stream->GetSampleRate()) / sampleRate;
+    //prev und next werden vor dem ersten Frame in MixVoice() gelesen
+    voice.frac = 2;
+    voice.sourcePosition = 0;
+    voice.prev.fill(0);
+    voice.next.fill(0);
+    voice.stagingCount = 0;
+    voice.stagingIndex = 0;
+    voice.gain = 1;
+    voice.gainStep = 0;
+    voice.rampFrames = 0;
+    voice.stopAtRampEnd = false;
+    voice.drained = false;
+
+}
+
+void AudioMixer::StopVoice(Voice& voice) {
+
+    if (voice.stream == nullptr) {
+        return;
+    }
+
+    MusicStream *stream = voice.stream;
+    voice.stream = nullptr;
+    Retire(stream);
+
+}
+
+void AudioMixer::Ramp(Voice& voice, float target, uint32_t frames, bool stopAtEnd) {
+
+    voice.stopAtRampEnd = stopAtEnd;
+
+    if (frames == 0) {
+        voice.gain = target;
+        voice.gainStep = 0;
+        voice.rampFrames = 0;
+        return;
+    }
+
+    voice.gainStep = (target - voice.gain) / static_cast<float>(frames);
+    voice.rampFrames = frames;
+    voice.gainTarget = target;
+
+}
+
+size_t AudioMixer::RemainingFrames(const Voice& voice) {
+
+    if (voice.looping) {
+        return NO_END;
+    }
+
+    //z.B. wenn die Datei kürzer ist als ihr Header behauptet
+    if (voice.drained) {
+        return 0;
+    }
+
+    const double remaining = static_cast<double>(voice.stream->GetFrameCount()) - voice.sourcePosition;
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    return static_cast<size_t>(std::ceil(remaining / voice.step));
+
+}
+
+bool AudioMixer::PullFrame(Voice& voice, std::array<float, CHANNELS>& frame) {
+
+    constexpr float SCALE = 1.0f / 32768.0f;
+
+    if (voice.stagingIndex == voice.stagingCount) {
+
+        voice.stagingCount = voice.stream->ReadFrames(voice.staging.data(), STAGING_FRAMES);
+        voice.stagingIndex = 0;
+
+        if (voice.stagingCount == 0) {
+
+            //IsDrained() erst nach dem leeren Lesen fragen: ist es dann true, kommt wirklich nichts mehr
+            if (voice.looping || !voice.stream->IsDrained()) {
+                return false;
+            }
+
+            voice.drained = true;
+            frame.fill(0);
+            return true;
+
+        }
+
+    }
+
+    const unsigned int channels = voice.stream->GetChannels();
+    const int16_t *samples = voice.staging.data() + voice.stagingIndex * channels;
+
+    frame[0] = samples[0] * SCALE;
+    frame[1] = channels == 1 ? frame[0] : samples[1] * SCALE;
+
+    ++voice.stagingIndex;
+    return true;
+
+}
+
+bool AudioMixer::AdvanceSource(Voice& voice) {
+
+    while (voice.frac >= 1) {
+
+        std::array<float, CHANNELS> frame;
+        if (!PullFrame(voice, frame)) {
+            return false;
+        }
+
+        voice.prev = voice.next;
+        voice.next = frame;
+        voice.frac -= 1;
+
+    }
+
+    return true;
+
+}
+
+void AudioMixer::MixVoice(Voice& voice, float *out, size_t frames) {
+
+    for (size_t i = 0; i < frames; ++i) {
+
+        //Decoder hängt hinterher: Stille ausgeben, aber Position und Rampe anhalten, damit weder das Ende noch ein Crossfade früher kommt
+        if (!AdvanceSource(voice)) {
+            continue;
+        }
+
+        const float gain = voice.gain;
+        if (voice.rampFrames > 0) {
+            voice.gain = --voice.rampFrames == 0 ? voice.gainTarget : voice.gain + voice.gainStep;
+        }
+
+        const float t = static_cast<float>(voice.frac);
+        for (unsigned int c = 0; c < CHANNELS; ++c) {
+            out[i * CHANNELS + c] += (voice.prev[c] + (voice.next[c] - voice.prev[c]) * t) * gain;
+        }
+
+        voice.frac += voice.step;
+        voice.sourcePosition += voice.step;
+
+    }
+
+}
+
+void AudioMixer::Settle() {
+
+    //jeder Durchlauf entfernt einen Eintrag oder ändert nichts mehr, die Schleife endet also
+    while (true) {
+
+        if (outgoing.stream != nullptr && ((outgoing.stopAtRampEnd && outgoing.rampFrames == 0) || RemainingFrames(outgoing) == 0)) {
+            StopVoice(outgoing);
+        }
+
+        if (state == SoundQueueState::SILENCE && silenceRemaining == 0) {
+            PopFront(false);
+            BeginFront();
+            continue;
+        }
+
+        if (current.stream == nullptr) {
+            return;
+        }
+
+        if ((current.stopAtRampEnd && current.rampFrames == 0) || RemainingFrames(current) == 0) {
+            PopFront(false);
+            BeginFront();
+            continue;
+        }
+
+        if (state == SoundQueueState::FADING_IN && current.rampFrames == 0) {
+            state = SoundQueueState::PLAYING;
+        }
+
+        //Überblenden beginnt so, dass der vorherige Eintrag genau mit dem Ende der Blende endet
+        const size_t remaining = RemainingFrames(current);
+        if (remaining != NO_END && entryCount > 1) {
+            const MixerEntry& next = entries[(entryHead + 1) % MAX_ENTRIES];
+            if (next.stream != nullptr && next.crossfadeFrames > 0 && remaining <= next.crossfadeFrames) {
+                BeginCrossfade(static_cast<uint32_t>(remaining));
+                continue;
+            }
+        }
+
+        return;
+
+    }
+
+}
+
+size_t AudioMixer::NextEventIn(size_t frames) const {
+
+    if (state == SoundQueueState::SILENCE) {
+        frames = std::min<size_t>(frames, silenceRemaining);
+    }
+
+    for (const Voice *voice : {&current, &outgoing}) {
+
+        if (voice->stream == nullptr) {
+            continue;
+        }
+        if (voice->rampFrames > 0) {
+            frames = std::min<size_t>(frames, voice->rampFrames);
+        }
+        frames = std::min(frames, RemainingFrames(*voice));
+
+    }
+
+    const size_t remaining = current.stream != nullptr ? RemainingFrames(current) : NO_END;
+    if (remaining != NO_END && entryCount > 1) {
+        const MixerEntry& next = entries[(entryHead + 1) % MAX_ENTRIES];
+        if (next.stream != nullptr && next.crossfadeFrames > 0) {
+            frames = std::min<size_t>(frames, remaining - next.crossfadeFrames);
+        }
+    }
+
+    return frames;
+
+}
+
+void AudioMixer::Render(float *out, size_t frames) {
+
+    std::fill(out, out + frames * CHANNELS, 0.0f);
+
+    ApplyCommands();
+
+    //in Abschnitte bis zum jeweils nächsten Ereignis teilen, damit jeder Übergang auf dem richtigen Frame liegt
+    size_t done = 0;
+    while (done < frames) {
+
+        Settle();
+
+        const size_t segment = NextEventIn(frames - done);
+        float *segmentOut = out + done * CHANNELS;
+
+        if (current.stream != nullptr) {
+            MixVoice(current, segmentOut, segment);
+        }
+        if (outgoing.stream != nullptr) {
+            MixVoice(outgoing, segmentOut, segment);
+        }
+        if (state == SoundQueueState::SILENCE) {
+            silenceRemaining -= static_cast<uint32_t>(segment);
+        }
+
+        done += segment;
+
+    }
+
+    Settle();
+    publishedState.store(state, std::memory_order_relaxed);
+
+}
+
+/**
+ * SoundQueue class
+ */
+
+//raylib übergibt dem Stream-Callback keinen Benutzerzeiger, deshalb kann nur ein Mixer gleichzeitig am Gerät hängen
+static std::atomic<AudioMixer*> deviceMixer{nullptr};
+
+static void RenderToDevice(void *buffer, unsigned int frames) {
+
+    if (AudioMixer *mixer = deviceMixer.load(std::memory_order_acquire)) {
+        mixer->Render(static_cast<float*>(buffer), frames);
+    } else {
+        std::memset(buffer, 0, static_cast<size_t>(frames) * AudioMixer::CHANNELS * sizeof(float));
+    }
+
+}
+
+SoundQueue::SoundQueue(unsigned int sampleRate) : mixer(sampleRate) {}
+
+SoundQueue::~SoundQueue() {
+
+    if (output.buffer != nullptr) {
+
+        //nach UnloadAudioStream() läuft der Callback nicht mehr, der Mixer fasst danach keinen Stream mehr an
+        if (IsAudioDeviceReady()) {
+            StopAudioStream(output);
+            UnloadAudioStream(output);
+        }
+        deviceMixer.store(nullptr, std::memory_order_release);
+
+    }
+
+}
+
+bool SoundQueue::AttachToDevice() {
+
+    if (output.buffer != nullptr) {
+        return true;
+    }
+
+    if (!IsAudioDeviceReady()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot attach SoundQueue: audio device is not initialized.");
+        return false;
+    }
+
+    AudioMixer *expected = nullptr;
+    if (!deviceMixer.compare_exchange_strong(expected, &mixer, std::memory_order_acq_rel)) {
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot attach SoundQueue: another SoundQueue is already attached.");
+        return false;
+    }
+
+    output = LoadAudioStream(mixer.GetSampleRate(), 32, AudioMixer::CHANNELS);
+    SetAudioStreamCallback(output, RenderToDevice);
+    PlayAudioStream(output);
+
+    return true;
+
+}
+
+uint32_t SoundQueue::MillisToFrames(int millis) const {
+
+    return static_cast<uint32_t>(static_cast<uint64_t>(std::max(millis, 0)) * mixer.GetSampleRate() / 1000);
+
+}
+
+bool SoundQueue::Post(const MixerCommand& command) {
+
+    if (!mixer.Post(command)) {
+        Debug::Log<Debug::LogLevel::ERROR>("SoundQueue command queue is full, dropping command.");
+        return false;
+    }
+
+    return true;
+
+}
+
+void SoundQueue::Queue(std::shared_ptr<MusicStream> stream, MixerEntry entry) {
+
+    if (inFlight.size() >= AudioMixer::MAX_ENTRIES) {
+        Debug::Log<Debug::LogLevel::WARNING>("SoundQueue is full, dropping entry.");
+        return;
+    }
+
+    if (stream != nullptr) {
+
+        if (std::ranges::find(inFlight, stream) != inFlight.end()) {
+            Debug::Log<Debug::LogLevel::ERROR>("A MusicStream can only be queued once at a time.");
+            return;
+        }
+
+        //der Mixer liest diesen Stream noch nicht, er darf also hier vorbereitet werden
+        stream->Prepare(entry.looping);
+        entry.stream = stream.get();
+
+    }
+
+    inFlight.push_back(std::move(stream));
+
+    if (!Post({MixerCommand::Type::QUEUE, entry, 0})) {
+        inFlight.pop_back();
+    }
+
+}
+
+void SoundQueue::QueueSilence(int silenceMillis) {
+
+    Queue(nullptr, {nullptr, MillisToFrames(silenceMillis), 0, 0, false});
+
+}
+
+void SoundQueue::Queue(std::shared_ptr<MusicStream> stream) {
+
+    //fehlende Dateien hat schon AssetManager::OpenMusicStream() geloggt
+    if (stream != nullptr) {
+        Queue(std::move(stream), {nullptr, 0, 0, 0, false});
+    }
+
+}
+
+void SoundQueue::QueueFadeIn(std::shared_ptr<MusicStream> stream, int fadeInMillis) {
+
+    if (stream != nullptr) {
+        Queue(std::move(stream), {nullptr, 0, MillisToFrames(fadeInMillis), 0, false});
+    }
+
+}
+
+void SoundQueue::QueueLooping(std::shared_ptr<MusicStream> stream) {
+
+    if (stream != nullptr) {
+        Queue(std::move(stream), {nullptr, 0, 0, 0, true});
+    }
+
+}
+
+void SoundQueue::QueueLoopingFadeIn(std::shared_ptr<MusicStream> stream, int fadeInMillis) {
+
+    if (stream != nullptr) {
+        Queue(std::move(stream), {nullptr, 0, MillisToFrames(fadeInMillis), 0, true});
+    }
+
+}
+
+void SoundQueue::QueueCrossfade(std::shared_ptr<MusicStream> stream, int crossfadeMillis, bool looping) {
+
+    if (stream != nullptr) {
+        Queue(std::move(stream), {nullptr, 0, 0, MillisToFrames(crossfadeMillis), looping});
+    }
+
+}
+
+void SoundQueue::SkipToNext() {
+
+    Post({MixerCommand::Type::SKIP, {}, 0});
+
+}
+
+void SoundQueue::FadeOutAndSkipToNext(int fadeOutMillis) {
+
+    Post({MixerCommand::Type::SKIP, {}, MillisToFrames(fadeOutMillis)});
+
+}
+
+void SoundQueue::Update() {
+
+    PROFILE_ZONE("SoundQueue::Update");
+
+    MusicStream *stream = nullptr;
+    while (mixer.PopRetired(stream)) {
+
+        const auto entry = std::ranges::find_if(inFlight, [stream](const std::shared_ptr<MusicStream>& queued) {
+            return queued.get() == stream;
+        });
+        if (entry == inFlight.end()) {
+            continue;
+        }
+
+        if (*entry != nullptr) {
+            (*entry)->Release();
+        }
+        inFlight.erase(entry);
+
+    }
+
+}
+
+bool SoundQueue::IsEmpty() {
+
+    return inFlight.empty();
+
+}
+
+void SoundQueue::Clear() {
+
+    Post({MixerCommand::Type::CLEAR, {}, 0});
+
+}
+
+AudioMixer& SoundQueue::GetMixer() {
+
+    return mixer;
+
+}
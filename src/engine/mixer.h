@@ -0,0 +1,215 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include "music.h"
+#include "ringbuffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class SoundQueueState {
+
+    EMPTY,
+    SILENCE,
+    PLAYING,
+    FADING_IN,
+    FADING_OUT
+
+};
+
+/**
+ * Ein Eintrag der SoundQueue, wie ihn der Mixer sieht. Alle Zeiten in Frames der Mixer-Samplerate.
+ */
+struct MixerEntry {
+    //nullptr für Stille
+    MusicStream *stream;
+    uint32_t silenceFrames;
+    uint32_t fadeInFrames;
+    //> 0: der vorherige Eintrag wird über so viele Frames aus- und dieser gleichzeitig eingeblendet
+    uint32_t crossfadeFrames;
+    bool looping;
+};
+
+/**
+ * Kommando vom Game-Thread an den Mixer.
+ */
+struct MixerCommand {
+    enum class Type {
+        QUEUE,
+        SKIP,
+        CLEAR
+    };
+    Type type;
+    MixerEntry entry;
+    //nur SKIP: 0 springt sofort zum nächsten Eintrag
+    uint32_t fadeOutFrames;
+};
+
+/**
+ * Der Zustandsautomat der SoundQueue (Stille, Ein- und Ausblenden, Loops, Crossfades), ausgeführt im Audio-Callback.
+ * Lautstärkerampen werden pro Sample berechnet und Übergänge liegen auf den Frame genau, unabhängig von der Tickrate des Spiels.
+ *
+ * Render() läuft auf dem Audio-Thread, alles andere auf dem Game-Thread. Beide Seiten reden nur über zwei lock-freie Ringpuffer miteinander:
+ * Kommandos hin, fertige Einträge zurück. Render() alloziert nicht und blockiert nie, und lässt sich ohne Audiogerät direkt in einen Puffer aufrufen.
+ */
+class AudioMixer final {
+    public:
+        static constexpr unsigned int DEFAULT_SAMPLE_RATE = 44100;
+        static constexpr unsigned int CHANNELS = 2;
+        static constexpr size_t MAX_ENTRIES = 32;
+        explicit AudioMixer(unsigned int sampleRate = DEFAULT_SAMPLE_RATE);
+        AudioMixer(const AudioMixer&) = delete;
+        AudioMixer& operator=(const AudioMixer&) = delete;
+        /**
+         * Nur Game-Thread. Gibt false zurück, wenn die Kommandoqueue voll ist.
+         */
+        bool Post(const MixerCommand& command);
+        /**
+         * Nur Game-Thread. Holt den nächsten Eintrag, den der Mixer fertig abgespielt oder verworfen hat; dessen Stream fasst er danach nicht mehr an.
+         * Für Stille ist stream nullptr.
+         */
+        bool PopRetired(MusicStream *& stream);
+        /**
+         * Nur Audio-Thread (oder Tests). Schreibt frames Frames als verschränktes Stereo-Float nach out.
+         */
+        void Render(float *out, size_t frames);
+        unsigned int GetSampleRate() const;
+        /**
+         * Zustand des vordersten Eintrags nach dem letzten Render(), nur zur Anzeige.
+         */
+        SoundQueueState GetState() const;
+    private:
+        static constexpr size_t STAGING_FRAMES = 256;
+        static constexpr size_t NO_END = SIZE_MAX;
+        /**
+         * Spielt einen Stream ab: liest blockweise aus dessen Ringpuffer, rechnet linear auf die Mixer-Samplerate um und wendet die Lautstärkerampe an.
+         */
+        struct Voice {
+            MusicStream *stream = nullptr;
+            bool looping = false;
+            //Resampling: prev/next sind die Quellframes links und rechts der aktuellen Position, frac der Abstand zu prev
+            double step = 1;
+            double frac = 0;
+            double sourcePosition = 0;
+            std::array<float, CHANNELS> prev{};
+            std::array<float, CHANNELS> next{};
+            std::array<int16_t, STAGING_FRAMES * CHANNELS> staging{};
+            size_t stagingCount = 0;
+            size_t stagingIndex = 0;
+            float gain = 1;
+            float gainStep = 0;
+            float gainTarget = 1;
+            uint32_t rampFrames = 0;
+            //nach Ende der Rampe (bei Lautstärke 0) wird die Stimme beendet
+            bool stopAtRampEnd = false;
+            //der Stream ist leergelesen, alles danach ist Stille
+            bool drained = false;
+        };
+        void ApplyCommands();
+        void Enqueue(const MixerEntry& entry);
+        /**
+         * Beginnt den vordersten Eintrag, oder geht in EMPTY über.
+         */
+        void BeginFront();
+        /**
+         * Entfernt den vordersten Eintrag. Dessen Stimme bleibt bestehen, wenn keepVoice gesetzt ist (zum Ausblenden), sonst wird er sofort zurückgemeldet.
+         */
+        void PopFront(bool keepVoice);
+        /**
+         * Blendet den vordersten Eintrag über frames aus und den nächsten gleichzeitig ein.
+         */
+        void BeginCrossfade(uint32_t frames);
+        void Skip(uint32_t fadeOutFrames);
+        void Clear();
+        /**
+         * Führt alle Übergänge aus, die genau jetzt fällig sind.
+         */
+        void Settle();
+        /**
+         * Wie viele der nächsten frames Frames ohne Übergang gemischt werden können.
+         */
+        size_t NextEventIn(size_t frames) const;
+        void StartVoice(Voice& voice, MusicStream *stream, bool looping);
+        void StopVoice(Voice& voice);
+        static void Ramp(Voice& voice, float target, uint32_t frames, bool stopAtEnd);
+        /**
+         * Frames bis zum Ende des Streams in Mixer-Frames, NO_END für Loops. Zählt nur tatsächlich gelesene Quellframes, ein hängender Decoder verschiebt das Ende also nach hinten.
+         */
+        static size_t RemainingFrames(const Voice& voice);
+        /**
+         * Liest einen Quellframe. Gibt false zurück, wenn der Decoder hinterherhängt; am Ende des Streams liefert sie Stille und setzt drained.
+         */
+        bool PullFrame(Voice& voice, std::array<float, CHANNELS>& frame);
+        /**
+         * Holt die Quellframes, die die Interpolation an der aktuellen Position braucht. Gibt false zurück, wenn sie noch nicht dekodiert sind.
+         */
+        bool AdvanceSource(Voice& voice);
+        void MixVoice(Voice& voice, float *out, size_t frames);
+        void Retire(MusicStream *stream);
+        const MixerEntry& Front() const;
+        unsigned int sampleRate;
+        //Game-Thread -> Mixer
+        SpscRingBuffer<MixerCommand, 64> commands;
+        //Mixer -> Game-Thread
+        SpscRingBuffer<MusicStream*, 128> retired;
+        //ab hier nur Audio-Thread
+        std::array<MixerEntry, MAX_ENTRIES> entries{};
+        size_t entryHead = 0;
+        size_t entryCount = 0;
+        SoundQueueState state = SoundQueueState::EMPTY;
+        uint32_t silenceRemaining = 0;
+        //current gehört zum vordersten Eintrag, outgoing ist ein bereits entfernter Eintrag, der noch ausgeblendet wird
+        Voice current;
+        Voice outgoing;
+        std::atomic<SoundQueueState> publishedState{SoundQueueState::EMPTY};
+};
+
+/**
+ * Warteschlange für Musik: Stücke und Pausen werden nacheinander abgespielt, wahlweise mit Ein-, Aus- oder Überblenden.
+ * Die eigentliche Wiedergabe macht ein AudioMixer im Audio-Callback; diese Klasse schickt ihm nur Kommandos und hält die Streams am Leben,
+ * bis er sie zurückmeldet. Nur auf dem Game-Thread benutzen.
+ *
+ * Ein MusicStream darf gleichzeitig nur einmal in der Queue stehen.
+ */
+class SoundQueue final {
+    public:
+        explicit SoundQueue(unsigned int sampleRate = AudioMixer::DEFAULT_SAMPLE_RATE);
+        ~SoundQueue();
+        SoundQueue(const SoundQueue&) = delete;
+        SoundQueue& operator=(const SoundQueue&) = delete;
+        /**
+         * Gibt den Mixer über ein raylib AudioStream aus. Braucht ein initialisiertes Audiogerät; es kann nur eine SoundQueue gleichzeitig angeschlossen sein.
+         * Ohne Aufruf passiert nur etwas, wenn jemand GetMixer().Render() aufruft.
+         */
+        bool AttachToDevice();
+        void QueueSilence(int silenceMillis);
+        void Queue(std::shared_ptr<MusicStream> stream);
+        void QueueFadeIn(std::shared_ptr<MusicStream> stream, int fadeInMillis);
+        void QueueLooping(std::shared_ptr<MusicStream> stream);
+        void QueueLoopingFadeIn(std::shared_ptr<MusicStream> stream, int fadeInMillis);
+        /**
+         * Blendet vom vorherigen Eintrag auf diesen über: crossfadeMillis vor dem Ende des vorherigen, oder sobald dieser übersprungen wird.
+         */
+        void QueueCrossfade(std::shared_ptr<MusicStream> stream, int crossfadeMillis, bool looping = false);
+        void SkipToNext();
+        void FadeOutAndSkipToNext(int fadeOutMillis);
+        /**
+         * Gibt Streams frei, die der Mixer fertig abgespielt hat. Einmal pro Tick aufrufen.
+         */
+        void Update();
+        bool IsEmpty();
+        void Clear();
+        AudioMixer& GetMixer();
+    private:
+        void Queue(std::shared_ptr<MusicStream> stream, MixerEntry entry);
+        bool Post(const MixerCommand& command);
+        uint32_t MillisToFrames(int millis) const;
+        AudioMixer mixer;
+        //alle Einträge, die der Mixer noch nicht zurückgemeldet hat; nullptr für Stille
+        std::vector<std::shared_ptr<MusicStream>> inFlight;
+        AudioStream output{};
+};
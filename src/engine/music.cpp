@@ -0,0 +1,333 @@
+#include "music.h"
+
+#include "../io/debug.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+/**
+ * WavStream class
+ */
+
+static uint16_t ReadU16(const unsigned char *bytes) {
+
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+
+}
+
+static uint32_t ReadU32(const unsigned char *bytes) {
+
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+
+}
+
+std::unique_ptr<WavStream> WavStream::OpenFile(const std::string& path) {
+
+    if (!std::filesystem::exists(path)) {
+        Debug::Log<Debug::LogLevel::DEBUG>("path does not exist: %s", path.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<WavStream> stream(new WavStream());
+    if (!stream->file.Open(path)) {
+        return nullptr;
+    }
+
+    if (!stream->Parse({stream->file.Data(), stream->file.Size()}, path)) {
+        return nullptr;
+    }
+
+    return stream;
+
+}
+
+std::unique_ptr<WavStream> WavStream::OpenMemory(std::span<const unsigned char> data, const std::string& name) {
+
+    std::unique_ptr<WavStream> stream(new WavStream());
+    if (!stream->Parse(data, name)) {
+        return nullptr;
+    }
+
+    return stream;
+
+}
+
+bool WavStream::Parse(std::span<const unsigned char> data, const std::string& name) {
+
+    constexpr size_t RIFF_HEADER_SIZE = 12;
+    constexpr size_t CHUNK_HEADER_SIZE = 8;
+    constexpr size_t FMT_MIN_SIZE = 16;
+    constexpr uint16_t FORMAT_PCM = 1;
+    constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    if (data.size() < RIFF_HEADER_SIZE || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        Debug::Log<Debug::LogLevel::ERROR>("Cannot stream %s: not a RIFF/WAVE file.", name.c_str());
+        return false;
+    }
+
+    bool hasFormat = false;
+    size_t offset = RIFF_HEADER_SIZE;
+
+    while (offset + CHUNK_HEADER_SIZE <= data.size()) {
+
+        const unsigned char *chunk = data.data() + offset;
+        const size_t chunkSize = ReadU32(chunk + 4);
+        const size_t bodyOffset = offset + CHUNK_HEADER_SIZE;
+        //abgeschnittene Dateien: so viel nehmen, wie da ist
+        const size_t bodySize = std::min(chunkSize, data.size() - bodyOffset);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && bodySize >= FMT_MIN_SIZE) {
+
+            const unsigned char *format = data.data() + bodyOffset;
+            uint16_t formatTag = ReadU16(format);
+            //WAVE_FORMAT_EXTENSIBLE: das eigentliche Format steht in den ersten zwei Bytes der SubFormat-GUID
+            if (formatTag == FORMAT_EXTENSIBLE && bodySize >= 26) {
+                formatTag = ReadU16(format + 24);
+            }
+
+            channels = ReadU16(format + 2);
+            sampleRate = ReadU32(format + 4);
+            const unsigned int bitsPerSample = ReadU16(format + 14);
+            bytesPerSample = bitsPerSample / 8;
+
+            if (formatTag != FORMAT_PCM || (bitsPerSample != 8 && bitsPerSample != 16) || channels == 0 || channels > 2 || sampleRate == 0) {
+                Debug::Log<Debug::LogLevel::ERROR>("Cannot stream %s: only 8 and 16 bit mono or stereo PCM is supported.", name.c_str());
+                return false;
+            }
+            hasFormat = true;
+
+        } else if (std::memcmp(chunk, "data", 4) == 0 && hasFormat) {
+
+            samples = data.subspan(bodyOffset, bodySize);
+            frameCount = samples.size() / (static_cast<size_t>(bytesPerSample) * channels);
+            position = 0;
+            return true;
+
+        }
+
+        //Chunks sind auf gerade Längen aufgefüllt
+        offset = bodyOffset + chunkSize + (chunkSize & 1);
+
+    }
+
+    Debug::Log<Debug::LogLevel::ERROR>("Cannot stream %s: no fmt or data chunk.", name.c_str());
+    return false;
+
+}
+
+size_t WavStream::Read(int16_t *out, size_t frames) {
+
+    frames = std::min(frames, frameCount - position);
+    const size_t sampleCount = frames * channels;
+    const unsigned char *from = samples.data() + position * channels * bytesPerSample;
+
+    if (bytesPerSample == 2) {
+
+        std::memcpy(out, from, sampleCount * sizeof(int16_t));
+
+    } else {
+
+        //8 Bit PCM ist vorzeichenlos mit Mittelwert 128
+        for (size_t i = 0; i < sampleCount; ++i) {
+            out[i] = static_cast<int16_t>((from[i] - 128) << 8);
+        }
+
+    }
+
+    position += frames;
+    return frames;
+
+}
+
+void WavStream::Rewind() {
+
+    position = 0;
+
+}
+
+unsigned int WavStream::GetSampleRate() const {
+
+    return sampleRate;
+
+}
+
+unsigned int WavStream::GetChannels() const {
+
+    return channels;
+
+}
+
+size_t WavStream::GetFrameCount() const {
+
+    return frameCount;
+
+}
+
+/**
+ * MusicDecoder class
+ */
+
+/**
+ * Der gemeinsame Decoder-Thread. Er füllt reihum die Ringpuffer aller lebenden MusicStreams und schläft dazwischen kurz; ein Ringpuffer
+ * reicht für viele Durchläufe, ein verspätetes Aufwachen ist also unkritisch. Geweckt wird er bewusst nicht, der Audio-Thread soll keine Syscalls machen.
+ */
+class MusicDecoder final {
+    public:
+        static MusicDecoder& Get() {
+
+            //absichtlich nie zerstört: MusicStreams in statischen Objekten melden sich womöglich erst nach dem Ende von main() ab
+            static MusicDecoder *decoder = new MusicDecoder();
+            return *decoder;
+
+        }
+        void Register(MusicStream *stream) {
+
+            std::lock_guard<std::mutex> lock(mutex);
+            streams.push_back(stream);
+
+        }
+        /**
+         * Blockiert, falls der Thread gerade in stream dekodiert; danach fasst er stream nicht mehr an.
+         */
+        void Unregister(MusicStream *stream) {
+
+            std::lock_guard<std::mutex> lock(mutex);
+            std::erase(streams, stream);
+
+        }
+    private:
+        MusicDecoder() : thread(&MusicDecoder::Run, this) {
+
+            thread.detach();
+
+        }
+        void Run() {
+
+            constexpr auto DECODE_INTERVAL = std::chrono::milliseconds(20);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+
+                for (MusicStream *stream : streams) {
+                    std::lock_guard<std::mutex> streamLock(stream->mutex);
+                    stream->DecodeLocked();
+                }
+
+                idle.wait_for(lock, DECODE_INTERVAL);
+
+            }
+
+        }
+        std::mutex mutex;
+        //nur zum Warten mit freigegebenem mutex, damit Register() und Unregister() durchkommen
+        std::condition_variable idle;
+        std::vector<MusicStream*> streams;
+        std::thread thread;
+};
+
+/**
+ * MusicStream class
+ */
+
+MusicStream::MusicStream(std::unique_ptr<WavStream> source)
+    : source(std::move(source)), sampleRate(this->source->GetSampleRate()), channels(this->source->GetChannels()), frameCount(this->source->GetFrameCount()) {
+
+    decodeBuffer.resize(RING_SAMPLES / 4);
+    MusicDecoder::Get().Register(this);
+
+}
+
+MusicStream::~MusicStream() {
+
+    MusicDecoder::Get().Unregister(this);
+
+}
+
+void MusicStream::DecodeLocked() {
+
+    if (!active) {
+        return;
+    }
+
+    while (true) {
+
+        const size_t frames = std::min(ring.GetWritable(), decodeBuffer.size()) / channels;
+        if (frames == 0) {
+            return;
+        }
+
+        const size_t read = source->Read(decodeBuffer.data(), frames);
+        ring.Write(decodeBuffer.data(), read * channels);
+
+        if (read < frames) {
+
+            //Ende der Datei: beim Loopen direkt weiter von vorne, ohne Lücke
+            if (!looping || frameCount == 0) {
+                sourceFinished.store(true, std::memory_order_release);
+                active = false;
+                return;
+            }
+            source->Rewind();
+
+        }
+
+    }
+
+}
+
+void MusicStream::Prepare(bool looping) {
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    source->Rewind();
+    //kein Mixer liest gerade, der Game-Thread darf deshalb kurz Consumer sein
+    ring.Clear();
+    this->looping = looping;
+    active = true;
+    sourceFinished.store(false, std::memory_order_relaxed);
+    DecodeLocked();
+
+}
+
+void MusicStream::Release() {
+
+    std::lock_guard<std::mutex> lock(mutex);
+    active = false;
+
+}
+
+size_t MusicStream::ReadFrames(int16_t *out, size_t frames) {
+
+    frames = std::min(frames, ring.GetReadable() / channels);
+    return ring.Read(out, frames * channels) / channels;
+
+}
+
+bool MusicStream::IsDrained() const {
+
+    //zuerst sourceFinished lesen: ist es gesetzt, liegen alle restlichen Samples schon im Ring
+    return sourceFinished.load(std::memory_order_acquire) && ring.GetReadable() == 0;
+
+}
+
+unsigned int MusicStream::GetSampleRate() const {
+
+    return sampleRate;
+
+}
+
+unsigned int MusicStream::GetChannels() const {
+
+    return channels;
+
+}
+
+size_t MusicStream::GetFrameCount() const {
+
+    return frameCount;
+
+}
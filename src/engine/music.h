@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include "ringbuffer.h"
+
+#include "../io/mapped_file.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Liest PCM-Frames aus einer .wav Datei, ohne sie vorher komplett zu dekodieren. Die Datei wird gemappt bzw. direkt aus einem
+ * gemounteten Archiv gelesen; gelesen wird immer nur der gerade benötigte Ausschnitt. Unterstützt unkomprimiertes PCM mit 8 oder 16 Bit, mono oder stereo.
+ */
+class WavStream final {
+    public:
+        /**
+         * Öffnet eine Datei im Dateisystem. Gibt nullptr zurück (und loggt), wenn sie fehlt oder kein unterstütztes .wav ist.
+         */
+        static std::unique_ptr<WavStream> OpenFile(const std::string& path);
+        /**
+         * Liest aus einem Speicherbereich, der länger leben muss als der Stream (z.B. ein Archiveintrag).
+         */
+        static std::unique_ptr<WavStream> OpenMemory(std::span<const unsigned char> data, const std::string& name);
+        /**
+         * Liest bis zu frameCount Frames als 16 Bit PCM (Kanäle verschränkt) nach out. Gibt die Anzahl gelesener Frames zurück, 0 am Ende.
+         */
+        size_t Read(int16_t *out, size_t frameCount);
+        void Rewind();
+        unsigned int GetSampleRate() const;
+        unsigned int GetChannels() const;
+        size_t GetFrameCount() const;
+    private:
+        WavStream() = default;
+        bool Parse(std::span<const unsigned char> data, const std::string& name);
+        MappedFile file;
+        std::span<const unsigned char> samples;
+        unsigned int sampleRate = 0;
+        unsigned int channels = 0;
+        unsigned int bytesPerSample = 0;
+        size_t frameCount = 0;
+        size_t position = 0;
+};
+
+/**
+ * Eine lange Tonspur zum gestreamten Abspielen, statt sie wie einen Sound komplett dekodiert im Speicher zu halten. Ein gemeinsamer
+ * Decoder-Thread füllt pro Stream einen Ringpuffer von ein paar hundert Millisekunden, den der AudioMixer auf dem Audio-Thread leert.
+ * Loops werden im Decoder geschlossen und sind deshalb lückenlos.
+ *
+ * Prepare() und Release() gehören dem Game-Thread, ReadFrames() und IsDrained() dem Mixer. Die SoundQueue sorgt dafür, dass sich beide nicht überschneiden.
+ */
+class MusicStream final {
+    public:
+        explicit MusicStream(std::unique_ptr<WavStream> source);
+        ~MusicStream();
+        MusicStream(const MusicStream&) = delete;
+        MusicStream& operator=(const MusicStream&) = delete;
+        /**
+         * Spult an den Anfang und füllt den Ringpuffer synchron vor, damit die Wiedergabe ohne Verzögerung starten kann.
+         * Nur aufrufen, solange kein Mixer aus dem Stream liest.
+         */
+        void Prepare(bool looping);
+        /**
+         * Hält den Decoder für diesen Stream an, bis zum nächsten Prepare().
+         */
+        void Release();
+        /**
+         * Liest bis zu frameCount ganze Frames als 16 Bit PCM (Kanäle verschränkt). Blockiert und alloziert nie; liefert weniger,
+         * wenn der Decoder hinterherhängt oder das Ende erreicht ist.
+         */
+        size_t ReadFrames(int16_t *out, size_t frameCount);
+        /**
+         * true, wenn das Ende der Datei erreicht (ohne Loop) und alles gelesen wurde.
+         */
+        bool IsDrained() const;
+        unsigned int GetSampleRate() const;
+        unsigned int GetChannels() const;
+        size_t GetFrameCount() const;
+    private:
+        friend class MusicDecoder;
+        //Ringpuffer in Samples: ~370ms Stereo bzw. ~740ms Mono bei 44,1kHz
+        static constexpr size_t RING_SAMPLES = 32768;
+        /**
+         * Füllt den Ringpuffer so weit wie möglich. Läuft auf dem Decoder-Thread, und einmal synchron in Prepare(). Erwartet, dass mutex gehalten wird.
+         */
+        void DecodeLocked();
+        std::unique_ptr<WavStream> source;
+        //Format der Quelle, unveränderlich und deshalb ohne Lock von jedem Thread lesbar
+        unsigned int sampleRate;
+        unsigned int channels;
+        size_t frameCount;
+        SpscRingBuffer<int16_t, RING_SAMPLES> ring;
+        //schützt source, looping, active und die Producer-Seite von ring
+        std::mutex mutex;
+        bool looping = false;
+        bool active = false;
+        std::vector<int16_t> decodeBuffer;
+        std::atomic<bool> sourceFinished{false};
+};
@@ -1,5 +1,12 @@
 #include "render.h"
 
+#include "../../include/rlgl.h"
+
+#include "../io/profiler.h"
+
+#include <algorithm>
+#include <tuple>
+
 void DrawTexturedRect(Texture2D texture, Rectangle rect) {
 
     const Rectangle sourceRec{0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)};
@@ -15,4 +22,181 @@ void FillScreenWithTexture(Texture2D texture) {
 
     DrawTexturedRect(texture, {0, 0, static_cast<float>(GetRenderWidth()), static_cast<float>(GetRenderHeight())});
 
-}
\ No newline at end of file
+}
+
+/**
+ * RlglSpriteBatchBackend class
+ */
+
+RlglSpriteBatchBackend *RlglSpriteBatchBackend::Get() {
+
+    static RlglSpriteBatchBackend backend;
+    return &backend;
+
+}
+
+void RlglSpriteBatchBackend::DrawRun(unsigned int texture, std::span<const SpriteQuad> quads) {
+
+    //in Stücken, die sicher in den Vertexpuffer von rlgl passen; ist er voll, zeichnet rlCheckRenderBatchLimit() ihn vorher leer
+    static constexpr size_t QUADS_PER_CHUNK = 1024;
+
+    rlSetTexture(texture);
+
+    for (size_t start = 0; start < quads.size(); start += QUADS_PER_CHUNK) {
+
+        const std::span<const SpriteQuad> chunk = quads.subspan(start, std::min(QUADS_PER_CHUNK, quads.size() - start));
+
+        rlCheckRenderBatchLimit(static_cast<int>(chunk.size() * 4));
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        //gleiche Eckenreihenfolge wie DrawTexturePro(): oben links, unten links, unten rechts, oben rechts
+        for (const SpriteQuad& quad : chunk) {
+
+            const float left = quad.dest.x;
+            const float top = quad.dest.y;
+            const float right = quad.dest.x + quad.dest.width;
+            const float bottom = quad.dest.y + quad.dest.height;
+
+            const float u0 = quad.uv.x;
+            const float v0 = quad.uv.y;
+            const float u1 = quad.uv.x + quad.uv.width;
+            const float v1 = quad.uv.y + quad.uv.height;
+
+            rlColor4ub(quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(left, top);
+
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(left, bottom);
+
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(right, bottom);
+
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(right, top);
+
+        }
+
+        rlEnd();
+
+    }
+
+    rlSetTexture(0);
+
+}
+
+/**
+ * CountingSpriteBatchBackend class
+ */
+
+void CountingSpriteBatchBackend::DrawRun(unsigned int texture, std::span<const SpriteQuad> quads) {
+
+    runTextures.push_back(texture);
+    drawnQuads.insert(drawnQuads.end(), quads.begin(), quads.end());
+
+}
+
+void CountingSpriteBatchBackend::Reset() {
+
+    runTextures.clear();
+    drawnQuads.clear();
+
+}
+
+size_t CountingSpriteBatchBackend::GetRunCount() const {
+
+    return runTextures.size();
+
+}
+
+const std::vector<unsigned int>& CountingSpriteBatchBackend::GetRunTextures() const {
+
+    return runTextures;
+
+}
+
+const std::vector<SpriteQuad>& CountingSpriteBatchBackend::GetDrawnQuads() const {
+
+    return drawnQuads;
+
+}
+
+/**
+ * SpriteBatch class
+ */
+
+SpriteBatch::SpriteBatch(SpriteBatchBackend *backend) : backend(backend) {}
+
+void SpriteBatch::Draw(Texture2D texture, Rectangle source, Rectangle dest, Color tint, int layer) {
+
+    if (texture.id == 0 || texture.width == 0 || texture.height == 0) {
+        return;
+    }
+
+    //wie DrawTexturePro(): bei negativer Größe beginnt das Quellrechteck an der gegenüberliegenden Kante
+    if (source.width < 0) {
+        source.x -= source.width;
+    }
+    if (source.height < 0) {
+        source.y -= source.height;
+    }
+
+    const float width = static_cast<float>(texture.width);
+    const float height = static_cast<float>(texture.height);
+
+    quads.push_back({
+        dest,
+        {source.x / width, source.y / height, source.width / width, source.height / height},
+        tint,
+        layer,
+        texture.id,
+        static_cast<uint32_t>(quads.size())
+    });
+
+}
+
+void SpriteBatch::Flush() {
+
+    runsLastFlush = 0;
+
+    if (quads.empty()) {
+        return;
+    }
+
+    PROFILE_ZONE("SpriteBatch::Flush");
+
+    std::sort(quads.begin(), quads.end(), [](const SpriteQuad& a, const SpriteQuad& b) {
+        return std::tie(a.layer, a.texture, a.order) < std::tie(b.layer, b.texture, b.order);
+    });
+
+    //nach dem Sortieren liegen gleiche Texturen eines Layers direkt hintereinander
+    size_t start = 0;
+    for (size_t i = 1; i <= quads.size(); ++i) {
+
+        if (i == quads.size() || quads[i].texture != quads[start].texture) {
+
+            backend->DrawRun(quads[start].texture, std::span<const SpriteQuad>(quads).subspan(start, i - start));
+            ++runsLastFlush;
+            start = i;
+
+        }
+
+    }
+
+    quads.clear();
+
+}
+
+size_t SpriteBatch::GetQueuedCount() const {
+
+    return quads.size();
+
+}
+
+size_t SpriteBatch::GetRunsLastFlush() const {
+
+    return runsLastFlush;
+
+}
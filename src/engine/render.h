@@ -2,13 +2,111 @@
 
 #include "../../include/raylib.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 class Screen {
     public:
         virtual ~Screen() = default;
         virtual void RenderScreen(float partialTick) = 0;
         virtual void UpdateGameplay() = 0;
+        /**
+         * Startet das Laden aller Assets, die der Screen zum Zeichnen braucht, im Hintergrund. Wird aufgerufen bevor der Screen sichtbar wird,
+         * z.B. während der Übergang vom vorherigen Screen noch ausblendet.
+         */
+        virtual void PreloadAssets() {}
 };
 
 void DrawTexturedRect(Texture2D texture, Rectangle rect);
 
-void FillScreenWithTexture(Texture2D texture);
\ No newline at end of file
+void FillScreenWithTexture(Texture2D texture);
+
+/**
+ * Ein Quad in einem SpriteBatch. uv ist in normierten Texturkoordinaten; eine negative Breite oder Höhe spiegelt das Bild.
+ */
+struct SpriteQuad {
+    Rectangle dest;
+    Rectangle uv;
+    Color tint;
+    int layer;
+    unsigned int texture;
+    //Reihenfolge des Einreihens, damit Quads mit gleicher Textur und gleichem Layer in der Reihenfolge gezeichnet werden, in der sie kamen
+    uint32_t order;
+};
+
+/**
+ * Alles, was der SpriteBatch an der GPU macht. Der Batch selbst sortiert und gruppiert nur, sodass sich mit einem Backend ohne GPU
+ * z.B. die Anzahl der Draw Calls zählen lässt.
+ */
+class SpriteBatchBackend {
+    public:
+        virtual ~SpriteBatchBackend() = default;
+        /**
+         * Zeichnet einen Lauf von Quads, die alle dieselbe Textur haben, mit einem einzigen Draw Call.
+         */
+        virtual void DrawRun(unsigned int texture, std::span<const SpriteQuad> quads) = 0;
+};
+
+/**
+ * Standard-Backend: schreibt jeden Lauf direkt in den Vertexpuffer von rlgl. rlgl zeichnet erst beim nächsten Texturwechsel, ein Lauf ist also ein Draw Call.
+ */
+class RlglSpriteBatchBackend final : public SpriteBatchBackend {
+    public:
+        virtual void DrawRun(unsigned int texture, std::span<const SpriteQuad> quads) override;
+        static RlglSpriteBatchBackend *Get();
+};
+
+/**
+ * Backend ohne GPU: merkt sich nur, was gezeichnet worden wäre. Damit lassen sich Draw Calls und Zeichenreihenfolge in Tests prüfen.
+ */
+class CountingSpriteBatchBackend final : public SpriteBatchBackend {
+    public:
+        virtual void DrawRun(unsigned int texture, std::span<const SpriteQuad> quads) override;
+        void Reset();
+        size_t GetRunCount() const;
+        /**
+         * Die Textur jedes Laufs, in Zeichenreihenfolge.
+         */
+        const std::vector<unsigned int>& GetRunTextures() const;
+        /**
+         * Alle Quads aller Läufe, in Zeichenreihenfolge.
+         */
+        const std::vector<SpriteQuad>& GetDrawnQuads() const;
+    private:
+        std::vector<unsigned int> runTextures;
+        std::vector<SpriteQuad> drawnQuads;
+};
+
+/**
+ * Sammelt Quads und zeichnet sie in Flush() nach Layer und Textur sortiert, ein Draw Call pro zusammenhängendem Lauf gleicher Textur.
+ * Zusammen mit einem TextureAtlas wird so z.B. ein ganzer Text oder ein Chunk voller Tiles mit einer Handvoll Draw Calls gezeichnet.
+ *
+ * Kleinere Layer liegen unten. Innerhalb eines Layers ist die Reihenfolge zwischen verschiedenen Texturen nicht festgelegt;
+ * was sich überlappen darf, gehört deshalb auf verschiedene Layer. Alles, was nach Flush() direkt gezeichnet wird, liegt darüber.
+ */
+class SpriteBatch final {
+    public:
+        /**
+         * Ownership des Backends bleibt beim Caller.
+         */
+        explicit SpriteBatch(SpriteBatchBackend *backend = RlglSpriteBatchBackend::Get());
+        /**
+         * Reiht ein Quad ein. source ist wie bei DrawTexturePro() in Pixeln, eine negative Höhe (z.B. für RenderTextures) spiegelt vertikal.
+         */
+        void Draw(Texture2D texture, Rectangle source, Rectangle dest, Color tint = WHITE, int layer = 0);
+        /**
+         * Zeichnet alle eingereihten Quads und leert den Batch.
+         */
+        void Flush();
+        size_t GetQueuedCount() const;
+        /**
+         * Anzahl der Läufe (= Draw Calls) des letzten Flush().
+         */
+        size_t GetRunsLastFlush() const;
+    private:
+        SpriteBatchBackend *backend;
+        std::vector<SpriteQuad> quads;
+        size_t runsLastFlush = 0;
+};
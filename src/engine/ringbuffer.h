@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Begrenzte, lock-freie Queue für beliebig viele Producer-Threads und genau einen Consumer-Thread.
+ * Jede Zelle trägt eine Sequenznummer, über die Producer freie Zellen reservieren und der Consumer fertig geschriebene erkennt.
+ * Ist die Queue voll, schlägt TryPush() fehl statt zu blockieren.
+ */
+template<typename T, size_t CAPACITY>
+class MpscRingBuffer {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    public:
+        MpscRingBuffer() : cells(std::make_unique<Cell[]>(CAPACITY)) {
+            for (size_t i = 0; i < CAPACITY; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        MpscRingBuffer(const MpscRingBuffer&) = delete;
+        MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+        /**
+         * Darf von jedem Thread aufgerufen werden.
+         */
+        template<typename U>
+        bool TryPush(U&& value) {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Cell *cell;
+
+            while (true) {
+
+                cell = &cells[pos & (CAPACITY - 1)];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+
+            }
+
+            cell->value = std::forward<U>(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        /**
+         * Darf nur vom Consumer-Thread aufgerufen werden.
+         */
+        bool TryPop(T& out) {
+            Cell *cell = &cells[dequeuePos & (CAPACITY - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+            if (sequence != dequeuePos + 1) {
+                return false;
+            }
+
+            out = std::move(cell->value);
+            cell->sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+            ++dequeuePos;
+            return true;
+        }
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+        std::unique_ptr<Cell[]> cells;
+        alignas(64) std::atomic<size_t> enqueuePos{0};
+        alignas(64) size_t dequeuePos = 0;
+};
+
+/**
+ * Begrenzter, lock-freier Ringpuffer für genau einen Producer- und genau einen Consumer-Thread. Gedacht für Blöcke trivial kopierbarer Werte
+ * (z.B. Audiosamples): Write() und Read() kopieren so viel wie gerade passt bzw. vorhanden ist und blockieren nie.
+ */
+template<typename T, size_t CAPACITY>
+class SpscRingBuffer {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRingBuffer copies values with memcpy");
+    public:
+        SpscRingBuffer() : values(std::make_unique<T[]>(CAPACITY)) {}
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+        /**
+         * Nur vom Producer-Thread. Gibt die Anzahl tatsächlich geschriebener Werte zurück.
+         */
+        size_t Write(const T *in, size_t count) {
+            const size_t write = writePos.load(std::memory_order_relaxed);
+            const size_t read = readPos.load(std::memory_order_acquire);
+            count = std::min(count, CAPACITY - (write - read));
+
+            const size_t offset = write & (CAPACITY - 1);
+            const size_t first = std::min(count, CAPACITY - offset);
+            std::memcpy(values.get() + offset, in, first * sizeof(T));
+            std::memcpy(values.get(), in + first, (count - first) * sizeof(T));
+
+            writePos.store(write + count, std::memory_order_release);
+            return count;
+        }
+        /**
+         * Nur vom Consumer-Thread. Gibt die Anzahl tatsächlich gelesener Werte zurück.
+         */
+        size_t Read(T *out, size_t count) {
+            const size_t read = readPos.load(std::memory_order_relaxed);
+            const size_t write = writePos.load(std::memory_order_acquire);
+            count = std::min(count, write - read);
+
+            const size_t offset = read & (CAPACITY - 1);
+            const size_t first = std::min(count, CAPACITY - offset);
+            std::memcpy(out, values.get() + offset, first * sizeof(T));
+            std::memcpy(out + first, values.get(), (count - first) * sizeof(T));
+
+            readPos.store(read + count, std::memory_order_release);
+            return count;
+        }
+        /**
+         * Werte, die der Consumer lesen kann.
+         */
+        size_t GetReadable() const {
+            return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_relaxed);
+        }
+        /**
+         * Platz, den der Producer beschreiben kann.
+         */
+        size_t GetWritable() const {
+            return CAPACITY - (writePos.load(std::memory_order_relaxed) - readPos.load(std::memory_order_acquire));
+        }
+        /**
+         * Verwirft alles Ungelesene. Nur vom Consumer-Thread, und nur während der Producer nachweislich nicht schreibt.
+         */
+        void Clear() {
+            readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    private:
+        std::unique_ptr<T[]> values;
+        alignas(64) std::atomic<size_t> writePos{0};
+        alignas(64) std::atomic<size_t> readPos{0};
+};
@@ -0,0 +1,377 @@
+#include "sfx.h"
+
+#include <algorithm>
+
+/**
+ * RaylibSfxBackend class
+ */
+
+RaylibSfxBackend *RaylibSfxBackend::Get() {
+
+    static RaylibSfxBackend backend;
+    return &backend;
+
+}
+
+bool RaylibSfxBackend::IsReady() {
+
+    return IsAudioDeviceReady();
+
+}
+
+Sound RaylibSfxBackend::CreateAlias(Sound source) {
+
+    return LoadSoundAlias(source);
+
+}
+
+void RaylibSfxBackend::DestroyAlias(Sound alias) {
+
+    UnloadSoundAlias(alias);
+
+}
+
+void RaylibSfxBackend::Play(Sound sound) {
+
+    PlaySound(sound);
+
+}
+
+void RaylibSfxBackend::Stop(Sound sound) {
+
+    StopSound(sound);
+
+}
+
+bool RaylibSfxBackend::IsPlaying(Sound sound) {
+
+    return IsSoundPlaying(sound);
+
+}
+
+void RaylibSfxBackend::SetVolume(Sound sound, float volume) {
+
+    SetSoundVolume(sound, volume);
+
+}
+
+void RaylibSfxBackend::SetPitch(Sound sound, float pitch) {
+
+    SetSoundPitch(sound, pitch);
+
+}
+
+void RaylibSfxBackend::SetPan(Sound sound, float pan) {
+
+    SetSoundPan(sound, pan);
+
+}
+
+/**
+ * SfxPool class
+ */
+
+SfxPool::SfxPool(AssetManager *assets, size_t voiceCount, SfxBackend *backend) : assets(assets), backend(backend), voices(voiceCount) {
+
+    //die Freiliste wächst nie über voiceCount, push_back() alloziert danach also nicht mehr
+    freeVoices.reserve(voiceCount);
+    for (size_t i = voiceCount; i > 0; --i) {
+        freeVoices.push_back(static_cast<uint32_t>(i - 1));
+    }
+
+}
+
+SfxPool::~SfxPool() {
+
+    //nach CloseAudioDevice() gibt es nichts mehr zu stoppen
+    if (!backend->IsReady()) {
+        return;
+    }
+
+    StopAll();
+
+    sounds.ForEach([this](AssetId, PooledSound& pooled) {
+        for (const Sound& alias : pooled.aliases) {
+            backend->DestroyAlias(alias);
+        }
+    });
+
+}
+
+bool SfxPool::Preload(AssetId id, size_t instances) {
+
+    const PooledSound *pooled = sounds.Find(id);
+    if (pooled != nullptr && pooled->aliases.size() >= std::clamp<size_t>(instances, 1, voices.size())) {
+        return true;
+    }
+
+    //das Handle statt eines Pins: der Sound bleibt so lange wie die Aliase und zählt danach wieder normal gegen das Budget
+    std::optional<SoundHandle> sound = assets->AcquireSound(id);
+    if (!sound.has_value()) {
+        return false;
+    }
+
+    Preload(id, sound->Get(), instances);
+    sounds.Find(id)->source = std::move(sound.value());
+    return true;
+
+}
+
+void SfxPool::Preload(AssetId id, Sound sound, size_t instances) {
+
+    instances = std::clamp<size_t>(instances, 1, voices.size());
+
+    PooledSound *pooled = sounds.Find(id);
+    if (pooled == nullptr) {
+        pooled = &sounds.Set(id, PooledSound{});
+    }
+
+    while (pooled->aliases.size() < instances) {
+        pooled->aliases.push_back(backend->CreateAlias(sound));
+        pooled->aliasVoice.push_back(NO_VOICE);
+    }
+
+}
+
+bool SfxPool::IsBusy(uint32_t voice) {
+
+    if (!voices[voice].active) {
+        return false;
+    }
+
+    if (backend->IsPlaying(voices[voice].sound)) {
+        return true;
+    }
+
+    Release(voice);
+    return false;
+
+}
+
+void SfxPool::Release(uint32_t voice) {
+
+    Voice& released = voices[voice];
+    if (!released.active) {
+        return;
+    }
+
+    released.active = false;
+    ++released.generation;
+
+    if (PooledSound *pooled = sounds.Find(released.id)) {
+        pooled->aliasVoice[released.alias] = NO_VOICE;
+    }
+    freeVoices.push_back(voice);
+
+}
+
+bool SfxPool::IsBetterVictim(uint32_t candidate, uint32_t best) const {
+
+    if (best == NO_VOICE) {
+        return true;
+    }
+
+    const Voice& a = voices[candidate];
+    const Voice& b = voices[best];
+
+    if (a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return a.started < b.started;
+
+}
+
+uint32_t SfxPool::AcquireVoice(int priority) {
+
+    //Stimmen werden nur beim Nachschauen als fertig erkannt; erst wenn die Freiliste leer ist, lohnt sich ein Durchlauf über alle
+    if (freeVoices.empty()) {
+        for (uint32_t voice = 0; voice < voices.size(); ++voice) {
+            IsBusy(voice);
+        }
+    }
+
+    if (!freeVoices.empty()) {
+        const uint32_t voice = freeVoices.back();
+        freeVoices.pop_back();
+        return voice;
+    }
+
+    uint32_t victim = NO_VOICE;
+    for (uint32_t voice = 0; voice < voices.size(); ++voice) {
+        if (IsBetterVictim(voice, victim)) {
+            victim = voice;
+        }
+    }
+
+    if (victim == NO_VOICE || voices[victim].priority > priority) {
+        return NO_VOICE;
+    }
+
+    backend->Stop(voices[victim].sound);
+    Release(victim);
+    ++stats.steals;
+
+    //Release() hat die Stimme gerade auf die Freiliste gelegt
+    freeVoices.pop_back();
+    return victim;
+
+}
+
+std::optional<SfxHandle> SfxPool::Play(AssetId id, const SfxParams& params) {
+
+    ++stats.triggers;
+
+    PooledSound *pooled = sounds.Find(id);
+    if (pooled == nullptr) {
+        ++stats.dropped;
+        return std::nullopt;
+    }
+
+    //zuerst einen freien Alias dieses Sounds suchen; sind alle belegt, wird die unwichtigste Instanz desselben Sounds neu gestartet
+    uint32_t alias = NO_VOICE;
+    uint32_t victim = NO_VOICE;
+
+    for (uint32_t i = 0; i < pooled->aliases.size(); ++i) {
+
+        const uint32_t user = pooled->aliasVoice[i];
+        if (user == NO_VOICE || !IsBusy(user)) {
+            alias = i;
+            break;
+        }
+        if (IsBetterVictim(user, victim)) {
+            victim = user;
+        }
+
+    }
+
+    uint32_t voice = NO_VOICE;
+
+    if (alias != NO_VOICE) {
+
+        voice = AcquireVoice(params.priority);
+
+    } else if (voices[victim].priority <= params.priority) {
+
+        alias = voices[victim].alias;
+        backend->Stop(voices[victim].sound);
+        Release(victim);
+        ++stats.steals;
+
+        freeVoices.pop_back();
+        voice = victim;
+
+    }
+
+    if (voice == NO_VOICE) {
+        ++stats.dropped;
+        return std::nullopt;
+    }
+
+    Voice& started = voices[voice];
+    started.sound = pooled->aliases[alias];
+    started.id = id;
+    started.alias = alias;
+    started.priority = params.priority;
+    started.started = playCounter++;
+    started.active = true;
+    pooled->aliasVoice[alias] = voice;
+
+    backend->SetVolume(started.sound, params.volume);
+    backend->SetPitch(started.sound, params.pitch);
+    backend->SetPan(started.sound, ToRaylibPan(params.pan));
+    backend->Play(started.sound);
+
+    return SfxHandle{voice, started.generation};
+
+}
+
+SfxPool::Voice *SfxPool::Resolve(SfxHandle handle) {
+
+    if (handle.voice >= voices.size() || voices[handle.voice].generation != handle.generation || !IsBusy(handle.voice)) {
+        return nullptr;
+    }
+
+    return &voices[handle.voice];
+
+}
+
+void SfxPool::Stop(SfxHandle handle) {
+
+    if (Voice *voice = Resolve(handle)) {
+        backend->Stop(voice->sound);
+        Release(handle.voice);
+    }
+
+}
+
+bool SfxPool::IsPlaying(SfxHandle handle) {
+
+    return Resolve(handle) != nullptr;
+
+}
+
+void SfxPool::SetVolume(SfxHandle handle, float volume) {
+
+    if (Voice *voice = Resolve(handle)) {
+        backend->SetVolume(voice->sound, volume);
+    }
+
+}
+
+void SfxPool::SetPitch(SfxHandle handle, float pitch) {
+
+    if (Voice *voice = Resolve(handle)) {
+        backend->SetPitch(voice->sound, pitch);
+    }
+
+}
+
+void SfxPool::SetPan(SfxHandle handle, float pan) {
+
+    if (Voice *voice = Resolve(handle)) {
+        backend->SetPan(voice->sound, ToRaylibPan(pan));
+    }
+
+}
+
+void SfxPool::StopAll() {
+
+    for (uint32_t voice = 0; voice < voices.size(); ++voice) {
+        if (voices[voice].active) {
+            backend->Stop(voices[voice].sound);
+            Release(voice);
+        }
+    }
+
+}
+
+size_t SfxPool::GetVoiceCount() const {
+
+    return voices.size();
+
+}
+
+size_t SfxPool::GetActiveCount() {
+
+    size_t active = 0;
+    for (uint32_t voice = 0; voice < voices.size(); ++voice) {
+        if (IsBusy(voice)) {
+            ++active;
+        }
+    }
+    return active;
+
+}
+
+const SfxStats& SfxPool::GetStats() const {
+
+    return stats;
+
+}
+
+float SfxPool::ToRaylibPan(float pan) {
+
+    //raylib erwartet 0..1 mit 0.5 als Mitte
+    return (std::clamp(pan, -1.0f, 1.0f) + 1.0f) * 0.5f;
+
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../../include/raylib.h"
+
+#include "assetid.h"
+#include "assets.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Verweist auf eine gestartete Stimme. Wird ungültig, sobald die Stimme ausgespielt hat oder gestohlen wurde; alle Funktionen
+ * mit einem ungültigen Handle tun dann einfach nichts.
+ */
+struct SfxHandle {
+    uint32_t voice;
+    uint32_t generation;
+};
+
+struct SfxParams {
+    float volume = 1.0f;
+    //1 ist die Originalhöhe, 2 eine Oktave höher (und doppelt so schnell)
+    float pitch = 1.0f;
+    //-1 ganz links, 0 Mitte, 1 ganz rechts
+    float pan = 0.0f;
+    //wichtigere Sounds dürfen unwichtigere verdrängen, nie umgekehrt
+    int priority = 0;
+};
+
+struct SfxStats {
+    uint64_t triggers = 0;
+    uint64_t steals = 0;
+    //nicht gespielt: Sound nicht vorgeladen oder alle Stimmen spielen Wichtigeres
+    uint64_t dropped = 0;
+};
+
+/**
+ * Alles, was der SfxPool am Audiogerät macht. Der Pool selbst verwaltet nur Stimmen und Aliase, sodass er sich mit einem Backend ohne
+ * Audiogerät testen und benchmarken lässt. pan ist hier schon im raylib-Bereich 0..1.
+ */
+class SfxBackend {
+    public:
+        virtual ~SfxBackend() = default;
+        virtual bool IsReady() = 0;
+        virtual Sound CreateAlias(Sound source) = 0;
+        virtual void DestroyAlias(Sound alias) = 0;
+        virtual void Play(Sound sound) = 0;
+        virtual void Stop(Sound sound) = 0;
+        virtual bool IsPlaying(Sound sound) = 0;
+        virtual void SetVolume(Sound sound, float volume) = 0;
+        virtual void SetPitch(Sound sound, float pitch) = 0;
+        virtual void SetPan(Sound sound, float pan) = 0;
+};
+
+/**
+ * Standard-Backend: reicht alles an raylib durch.
+ */
+class RaylibSfxBackend final : public SfxBackend {
+    public:
+        virtual bool IsReady() override;
+        virtual Sound CreateAlias(Sound source) override;
+        virtual void DestroyAlias(Sound alias) override;
+        virtual void Play(Sound sound) override;
+        virtual void Stop(Sound sound) override;
+        virtual bool IsPlaying(Sound sound) override;
+        virtual void SetVolume(Sound sound, float volume) override;
+        virtual void SetPitch(Sound sound, float pitch) override;
+        virtual void SetPan(Sound sound, float pan) override;
+        static RaylibSfxBackend *Get();
+};
+
+/**
+ * Spielt viele kurze Soundeffekte gleichzeitig ab (Schritte, Treffer, Klicks). Ein raylib Sound kann sich nicht mit sich selbst überlagern,
+ * deshalb bekommt jeder Sound beim Vorladen mehrere Aliase, die sich seine Sampledaten teilen. Insgesamt spielen höchstens voiceCount Stimmen;
+ * ist keine frei, wird die unwichtigste, bei Gleichstand die älteste, gestohlen.
+ *
+ * Alles Allozieren passiert in Preload(). Play() und die Handle-Funktionen allozieren nie und sind für viele Aufrufe pro Tick gedacht.
+ * Nur auf dem Main-Thread benutzen; muss vor dem AssetManager zerstört werden, dem die Sounds gehören.
+ */
+class SfxPool final {
+    public:
+        static constexpr size_t DEFAULT_VOICES = 32;
+        static constexpr size_t DEFAULT_INSTANCES = 4;
+        /**
+         * Ownership des Backends bleibt beim Caller. assets darf nullptr sein, wenn nur die Preload() Variante mit fertigem Sound benutzt wird.
+         */
+        explicit SfxPool(AssetManager *assets, size_t voiceCount = DEFAULT_VOICES, SfxBackend *backend = RaylibSfxBackend::Get());
+        ~SfxPool();
+        SfxPool(const SfxPool&) = delete;
+        SfxPool& operator=(const SfxPool&) = delete;
+        /**
+         * Lädt einen Sound über den AssetManager und legt instances Aliase an, d.h. so oft kann er sich höchstens selbst überlagern.
+         * Ein zweiter Aufruf kann die Anzahl nur erhöhen.
+         */
+        bool Preload(AssetId id, size_t instances = DEFAULT_INSTANCES);
+        /**
+         * Wie Preload(), aber mit einem schon geladenen Sound. Der Caller muss ihn geladen halten, solange der Pool lebt.
+         */
+        void Preload(AssetId id, Sound sound, size_t instances = DEFAULT_INSTANCES);
+        /**
+         * Startet einen vorgeladenen Sound. Gibt std::nullopt zurück, wenn er nicht vorgeladen ist oder keine Stimme mit höchstens gleicher Priorität frei zu machen war.
+         */
+        std::optional<SfxHandle> Play(AssetId id, const SfxParams& params = {});
+        void Stop(SfxHandle handle);
+        bool IsPlaying(SfxHandle handle);
+        void SetVolume(SfxHandle handle, float volume);
+        void SetPitch(SfxHandle handle, float pitch);
+        void SetPan(SfxHandle handle, float pan);
+        void StopAll();
+        size_t GetVoiceCount() const;
+        /**
+         * Stimmen, die gerade spielen.
+         */
+        size_t GetActiveCount();
+        const SfxStats& GetStats() const;
+    private:
+        static constexpr uint32_t NO_VOICE = UINT32_MAX;
+        struct Voice {
+            Sound sound{};
+            AssetId id{};
+            uint32_t alias = 0;
+            int priority = 0;
+            //Startreihenfolge, für "die älteste zuerst"
+            uint64_t started = 0;
+            uint32_t generation = 0;
+            bool active = false;
+        };
+        struct PooledSound {
+            std::vector<Sound> aliases;
+            //welche Stimme welchen Alias gerade benutzt, NO_VOICE wenn frei
+            std::vector<uint32_t> aliasVoice;
+            //hält den Sound unter den Aliasen fest; ungültig, wenn der Sound direkt übergeben wurde
+            SoundHandle source;
+        };
+        /**
+         * Ob die Stimme noch spielt. Eine ausgespielte Stimme wird dabei freigegeben.
+         */
+        bool IsBusy(uint32_t voice);
+        void Release(uint32_t voice);
+        /**
+         * Ob candidate eher gestohlen werden soll als best: niedrigere Priorität, bei Gleichstand älter. best darf NO_VOICE sein.
+         */
+        bool IsBetterVictim(uint32_t candidate, uint32_t best) const;
+        uint32_t AcquireVoice(int priority);
+        Voice *Resolve(SfxHandle handle);
+        static float ToRaylibPan(float pan);
+        AssetManager *assets;
+        SfxBackend *backend;
+        std::vector<Voice> voices;
+        std::vector<uint32_t> freeVoices;
+        AssetSlots<PooledSound> sounds;
+        uint64_t playCounter = 0;
+        SfxStats stats;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * Verweis auf ein Element einer SlotMap<T>. Die Generation macht Handles auf entfernte Elemente ungültig, auch wenn ihr Slot
+ * inzwischen wiederverwendet wird. Ein default-konstruiertes Handle ist immer ungültig.
+ */
+template<typename T>
+struct SlotHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsValid() const {
+        return index != INVALID_INDEX;
+    }
+    bool operator==(const SlotHandle& other) const = default;
+};
+
+/**
+ * Container mit stabilen Handles: Einfügen, Entfernen und Nachschlagen in O(1), und die Elemente liegen trotzdem dicht hintereinander
+ * (Values() bzw. begin()/end()), damit Durchläufe über alle Elemente cachefreundlich sind. Beim Entfernen rückt das letzte Element
+ * in die Lücke; Zeiger und Referenzen auf Elemente sind deshalb nur bis zum nächsten Insert()/Erase() gültig, Handles dagegen bleiben es.
+ */
+template<typename T>
+class SlotMap {
+    public:
+        using Handle = SlotHandle<T>;
+        Handle Insert(T value) {
+            return Emplace(std::move(value));
+        }
+        template<typename... Args>
+        Handle Emplace(Args&&... args) {
+
+            uint32_t index;
+            if (freeHead != NO_SLOT) {
+                index = freeHead;
+                freeHead = slots[index].dense;
+            } else {
+                index = static_cast<uint32_t>(slots.size());
+                slots.push_back({NO_SLOT, 0});
+            }
+
+            values.emplace_back(std::forward<Args>(args)...);
+            denseToSlot.push_back(index);
+            slots[index].dense = static_cast<uint32_t>(values.size() - 1);
+
+            return {index, slots[index].generation};
+
+        }
+        /**
+         * Gibt false zurück, wenn handle schon ungültig war.
+         */
+        bool Erase(Handle handle) {
+
+            if (!Contains(handle)) {
+                return false;
+            }
+
+            Slot& slot = slots[handle.index];
+            const uint32_t dense = slot.dense;
+            const uint32_t last = static_cast<uint32_t>(values.size() - 1);
+
+            //das letzte Element füllt die Lücke
+            if (dense != last) {
+                values[dense] = std::move(values[last]);
+                denseToSlot[dense] = denseToSlot[last];
+                slots[denseToSlot[dense]].dense = dense;
+            }
+            values.pop_back();
+            denseToSlot.pop_back();
+
+            ++slot.generation;
+            slot.dense = freeHead;
+            freeHead = handle.index;
+
+            return true;
+
+        }
+        T *Get(Handle handle) {
+            return Contains(handle) ? &values[slots[handle.index].dense] : nullptr;
+        }
+        const T *Get(Handle handle) const {
+            return Contains(handle) ? &values[slots[handle.index].dense] : nullptr;
+        }
+        bool Contains(Handle handle) const {
+            //freie Slots haben eine neuere Generation als jedes ausgegebene Handle; der Rückverweis fängt zusätzlich erfundene Handles ab
+            return handle.index < slots.size() && slots[handle.index].generation == handle.generation
+                && slots[handle.index].dense < denseToSlot.size() && denseToSlot[slots[handle.index].dense] == handle.index;
+        }
+        /**
+         * Das Handle des Elements an Position dense in Values().
+         */
+        Handle HandleAt(size_t dense) const {
+            const uint32_t index = denseToSlot[dense];
+            return {index, slots[index].generation};
+        }
+        std::span<T> Values() {
+            return values;
+        }
+        std::span<const T> Values() const {
+            return values;
+        }
+        auto begin() {
+            return values.begin();
+        }
+        auto end() {
+            return values.end();
+        }
+        auto begin() const {
+            return values.begin();
+        }
+        auto end() const {
+            return values.end();
+        }
+        size_t Size() const {
+            return values.size();
+        }
+        bool Empty() const {
+            return values.empty();
+        }
+        /**
+         * Entfernt alle Elemente. Alle bisherigen Handles werden ungültig.
+         */
+        void Clear() {
+            for (size_t dense = 0; dense < values.size(); ++dense) {
+                const uint32_t index = denseToSlot[dense];
+                ++slots[index].generation;
+                slots[index].dense = freeHead;
+                freeHead = index;
+            }
+            values.clear();
+            denseToSlot.clear();
+        }
+    private:
+        static constexpr uint32_t NO_SLOT = UINT32_MAX;
+        struct Slot {
+            //Position in values; bei freien Slots der nächste freie Slot
+            uint32_t dense;
+            uint32_t generation;
+        };
+        std::vector<T> values;
+        //parallel zu values: zu welchem Slot das Element gehört
+        std::vector<uint32_t> denseToSlot;
+        std::vector<Slot> slots;
+        uint32_t freeHead = NO_SLOT;
+};
@@ -0,0 +1,76 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount) {
+
+    if (threadCount == 0) {
+
+        const size_t hardware = std::thread::hardware_concurrency();
+        threadCount = std::clamp<size_t>(hardware > 1 ? hardware - 1 : 1, 1, 4);
+
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+
+}
+
+ThreadPool::~ThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+
+    jobAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+
+    jobAvailable.notify_one();
+
+}
+
+size_t ThreadPool::GetThreadCount() const {
+
+    return workers.size();
+
+}
+
+void ThreadPool::WorkerLoop() {
+
+    while (true) {
+
+        std::function<void()> job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stop || !jobs.empty(); });
+
+            //beim Beenden werden noch ausstehende Jobs abgearbeitet
+            if (jobs.empty()) {
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        job();
+
+    }
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Einfacher Threadpool mit einer gemeinsamen FIFO-Queue. Jobs dürfen keine raylib-Funktionen aufrufen, die einen OpenGL-Kontext brauchen.
+ */
+class ThreadPool final {
+    public:
+        /**
+         * threadCount == 0 wählt anhand der Hardware, lässt aber immer einen Kern für den Main-Thread frei.
+         */
+        ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        void Submit(std::function<void()> job);
+        size_t GetThreadCount() const;
+    private:
+        void WorkerLoop();
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable jobAvailable;
+        std::deque<std::function<void()>> jobs;
+        bool stop = false;
+};
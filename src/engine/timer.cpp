@@ -3,39 +3,101 @@
 #include "../io/debug.h"
 
 #include <chrono>
+#include <cmath>
+
+/**
+ * Clocks
+ */
+
+const Clock *Clock::Steady() {
+
+    static const SteadyClock steady;
+    return &steady;
+
+}
+
+long long SteadyClock::NowNanos() const {
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+}
+
+ManualClock::ManualClock(long long startNanos) : now(startNanos) {}
+
+long long ManualClock::NowNanos() const {
+
+    return now.load(std::memory_order_acquire);
+
+}
+
+void ManualClock::Set(long long nanos) {
+
+    now.store(nanos, std::memory_order_release);
+
+}
+
+void ManualClock::Advance(long long nanos) {
+
+    now.fetch_add(nanos, std::memory_order_acq_rel);
+
+}
+
+void ManualClock::AdvanceMillis(double millis) {
+
+    Advance(static_cast<long long>(millis * 1'000'000.0));
+
+}
+
+/**
+ * TickTimer class
+ */
 
 long long TickTimer::Now() {
 
-    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return Clock::Steady()->NowNanos() / 1'000'000;
 
 }
 
-TickTimer::TickTimer(int ticksPerSecond) {
+TickTimer::TickTimer(double ticksPerSecond, const Clock *clock) : clock(clock) {
 
-    tickTime = 1000/ticksPerSecond;
+    tickNanos = 1'000'000'000.0 / ticksPerSecond;
     Reset();
 
 }
 
 void TickTimer::Reset() {
 
-    lastTick = Now();
+    startTime = clock->NowNanos();
+    ticksSinceStart = 0;
+
+}
+
+long long TickTimer::LastTickTime() const {
+
+    //immer vom Startzeitpunkt aus rechnen statt Tickdauern aufzuaddieren, sonst summieren sich Rundungsfehler
+    return startTime + std::llround(ticksSinceStart * tickNanos);
+
+}
+
+long long TickTimer::GetElapsedNanos() const {
+
+    return clock->NowNanos() - LastTickTime();
 
 }
 
 long long TickTimer::GetElapsedMillis() const {
 
-    return Now() - lastTick;
+    return GetElapsedNanos() / 1'000'000;
 
 }
 
 bool TickTimer::ShouldTick() {
 
-    const long long elapsed = GetElapsedMillis();
+    const long long ticks = static_cast<long long>((clock->NowNanos() - startTime) / tickNanos);
 
-    if (elapsed >= tickTime) {
+    if (ticks > ticksSinceStart) {
 
-        lastTick = Now();
+        ticksSinceStart = ticks;
         return true;
 
     } else {
@@ -46,22 +108,66 @@ bool TickTimer::ShouldTick() {
 
 }
 
-int TickTimer::GetElapsedTicks() {
+int TickTimer::GetElapsedTicks() const {
+
+    return static_cast<int>(GetElapsedNanos() / tickNanos);
 
-    const int millisF = static_cast<int>(GetElapsedMillis());
-    const int tickTime = static_cast<int>(this->tickTime);
+}
 
-    return millisF/tickTime;
+float TickTimer::GetPartialTick() const {
 
+    return static_cast<float>(GetElapsedNanos() / tickNanos);
 
 }
 
-float TickTimer::GetPartialTick() const {
+const Clock *TickTimer::GetClock() const {
+
+    return clock;
+
+}
+
+/**
+ * FixedTimestep class
+ */
+
+FixedTimestep::FixedTimestep(int ticksPerSecond, int maxCatchUpTicks, const Clock *clock)
+: clock(clock), tickNanos(1'000'000'000LL / ticksPerSecond), maxCatchUpTicks(maxCatchUpTicks)
+{
+
+    Reset();
+
+}
 
-    const float millisF = static_cast<float>(GetElapsedMillis());
-    const float tickTimeF = static_cast<float>(tickTime);
-    const float partial = millisF/tickTimeF;
+void FixedTimestep::Reset() {
 
-    return partial;
+    lastTime = clock->NowNanos();
+    accumulator = 0;
 
-}
\ No newline at end of file
+}
+
+int FixedTimestep::BeginFrame() {
+
+    const long long now = clock->NowNanos();
+    accumulator += now - lastTime;
+    lastTime = now;
+
+    const long long maxAccumulated = tickNanos * maxCatchUpTicks;
+    if (accumulator >= maxAccumulated) {
+
+        //Spiral of death: mehr als maxCatchUpTicks holen wir nicht nach, der Rest wird verworfen
+        accumulator = maxAccumulated;
+
+    }
+
+    const int ticks = static_cast<int>(accumulator / tickNanos);
+    accumulator -= ticks * tickNanos;
+
+    return ticks;
+
+}
+
+float FixedTimestep::GetAlpha() const {
+
+    return static_cast<float>(static_cast<double>(accumulator) / static_cast<double>(tickNanos));
+
+}
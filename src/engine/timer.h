@@ -2,17 +2,95 @@
 
 #include "../../include/raylib.h"
 
+#include <atomic>
+
+/**
+ * Zeitquelle für alle Timer. Liefert monoton steigende Nanosekunden mit beliebigem Nullpunkt.
+ * Zeitabhängiger Code bekommt eine Clock übergeben, damit er in Tests und Benchmarks mit einer ManualClock deterministisch läuft.
+ */
+class Clock {
+    public:
+        virtual ~Clock() = default;
+        virtual long long NowNanos() const = 0;
+        /**
+         * Die Standarduhr (std::chrono::steady_clock). Ist nicht von Zeitumstellungen oder NTP betroffen.
+         */
+        static const Clock *Steady();
+};
+
+class SteadyClock final : public Clock {
+    public:
+        virtual long long NowNanos() const override;
+};
+
+/**
+ * Uhr, die nur weiterläuft wenn man sie explizit stellt. Threadsicher.
+ */
+class ManualClock final : public Clock {
+    public:
+        ManualClock(long long startNanos = 0);
+        virtual long long NowNanos() const override;
+        void Set(long long nanos);
+        void Advance(long long nanos);
+        void AdvanceMillis(double millis);
+    private:
+        std::atomic<long long> now;
+};
+
 class TickTimer final {
     public:
-        TickTimer(int ticksPerSecond);
+        /**
+         * ticksPerSecond darf gebrochen sein, die Tickdauer wird intern in Nanosekunden ohne Rundung auf ganze Millisekunden geführt.
+         */
+        TickTimer(double ticksPerSecond, const Clock *clock = Clock::Steady());
         ~TickTimer() = default;
+        /**
+         * Gibt true zurück, wenn seit dem letzten Tick mindestens eine Tickdauer vergangen ist. Verpasste Ticks werden zusammengefasst,
+         * der angebrochene Rest bleibt aber erhalten, sodass der Timer über lange Zeit nicht driftet.
+         */
         bool ShouldTick();
-        int GetElapsedTicks();
+        int GetElapsedTicks() const;
         float GetPartialTick() const;
         void Reset();
         long long GetElapsedMillis() const;
+        long long GetElapsedNanos() const;
+        const Clock *GetClock() const;
+        /**
+         * Aktuelle Zeit der Standarduhr in Millisekunden.
+         */
         static long long Now();
     private:
-        long long lastTick = -1;
-        long long tickTime = -1;
-};
\ No newline at end of file
+        const Clock *clock;
+        double tickNanos;
+        long long startTime = 0;
+        long long ticksSinceStart = 0;
+        long long LastTickTime() const;
+};
+
+/**
+ * Fixed-Timestep mit Akkumulator. Die vergangene Zeit wird gesammelt und in ganzen Ticks abgearbeitet, Überschuss bleibt für den nächsten Frame erhalten.
+ * Hängt ein Frame zu lange, werden höchstens maxCatchUpTicks nachgeholt und der Rest verworfen, damit sich die Simulation nicht immer weiter hinterherzieht.
+ */
+class FixedTimestep final {
+    public:
+        FixedTimestep(int ticksPerSecond, int maxCatchUpTicks, const Clock *clock = Clock::Steady());
+        ~FixedTimestep() = default;
+        /**
+         * Misst die seit dem letzten Aufruf vergangene Zeit und gibt zurück, wie viele Ticks jetzt simuliert werden sollen.
+         */
+        int BeginFrame();
+        /**
+         * Anteil des angefangenen Ticks im Bereich [0, 1), zum Interpolieren zwischen letztem und aktuellem Simulationsstand beim Rendern.
+         */
+        float GetAlpha() const;
+        /**
+         * Verwirft die gesammelte Zeit, z.B. nach dem Laden einer Welt.
+         */
+        void Reset();
+    private:
+        const Clock *clock;
+        long long tickNanos;
+        int maxCatchUpTicks;
+        long long lastTime;
+        long long accumulator = 0;
+};
@@ -1,11 +1,14 @@
 #include "screens.h"
 
 #include "sunworld.h"
+#include "world/worldfile.h"
 
 #include "../io/debug.h"
 
 #include "../../include/raylib.h"
 
+#include <cmath>
+
 /**
  * ScreenMainMenu
  */
@@ -21,20 +24,126 @@ void ScreenMainMenu::UpdateGameplay() {
     if (IsKeyDown(KEY_SPACE)) {
 
         Sunworld::GetMainSoundQueue()->FadeOutAndSkipToNext(5000);
-        Sunworld::SwitchScreen(new ScreenMainMenu());
+        Sunworld::SwitchScreen(new ScreenWorld());
 
     }
 
 }
 
+void ScreenMainMenu::PreloadAssets() {
+
+    background = assetManager.RequestTexture(ASSET_ID("background.png"));
+    logo = assetManager.RequestAtlasSprite(ASSET_ID("logo.png"));
+
+}
+
 void ScreenMainMenu::RenderScreen(float partialTick) {
 
-    Texture2D background = assetManager.GetTexture("background.png").value();
-    FillScreenWithTexture(background);
+    if (!background.IsValid()) {
+        PreloadAssets();
+    }
+
+    //solange die Texturen noch laden wird einfach nichts gezeichnet, statt den Frame zu blockieren
+    if (const std::optional<Texture2D> backgroundTexture = background.Get()) {
+        FillScreenWithTexture(backgroundTexture.value());
+    }
+
+    if (const std::optional<AtlasSprite> logoSprite = logo.Get()) {
+        const float x = static_cast<float>(GetRenderWidth()/2) - logoSprite->source.width/2;
+        const float y = static_cast<float>(GetRenderHeight()/2) - logoSprite->source.height/2;
+        DrawTextureRec(logoSprite->texture, logoSprite->source, {x, y}, WHITE);
+    }
+
+}
+
+/**
+ * ScreenWorld
+ */
+
+ScreenWorld::ScreenWorld() : chunkBackend(Sunworld::GetCoreAssetManager()), tileRenderer(&chunkBackend) {
+
+    //ohne Weltdatei (z.B. schreibgeschütztes Verzeichnis) streamt der Streamer leere Chunks, die beim Entladen verworfen werden
+    WorldFile *file = WorldFile::Open(WORLD_PATH);
+    if (file == nullptr) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open world file %s, changes will not be saved.", WORLD_PATH);
+    }
+    Sunworld::OpenWorld(file);
+
+    camera.zoom = 2.0f;
+
+}
+
+ScreenWorld::~ScreenWorld() {
+
+    //die gebackenen Chunks gehören zur Welt, die gleich geschlossen wird
+    tileRenderer.Clear();
+    Sunworld::CloseWorld();
+
+}
+
+void ScreenWorld::UpdateGameplay() {
 
-    Texture2D logoTexture = assetManager.GetTexture("logo.png").value();
-    const int x = GetRenderWidth()/2 - logoTexture.width/2;
-    const int y = GetRenderHeight()/2 - logoTexture.height/2;
-    DrawTexture(logoTexture, x, y, WHITE);
+    static constexpr float CAMERA_SPEED = 8.0f;
 
-}
\ No newline at end of file
+    previousTarget = camera.target;
+
+    if (IsKeyDown(KEY_LEFT)) {
+        camera.target.x -= CAMERA_SPEED;
+    }
+    if (IsKeyDown(KEY_RIGHT)) {
+        camera.target.x += CAMERA_SPEED;
+    }
+    if (IsKeyDown(KEY_UP)) {
+        camera.target.y -= CAMERA_SPEED;
+    }
+    if (IsKeyDown(KEY_DOWN)) {
+        camera.target.y += CAMERA_SPEED;
+    }
+
+    if (ChunkStreamer *streamer = Sunworld::GetChunkStreamer()) {
+
+        const ChunkPos center{
+            static_cast<int>(std::floor(camera.target.x / CHUNK_PIXEL_SIZE)),
+            static_cast<int>(std::floor(camera.target.y / CHUNK_PIXEL_SIZE))
+        };
+        streamer->SetCenter(center);
+
+    }
+
+}
+
+void ScreenWorld::RenderScreen(float partialTick) {
+
+    static constexpr Color SKY{120, 170, 230, 255};
+
+    ClearBackground(SKY);
+
+    const World *world = Sunworld::GetWorld();
+    if (world == nullptr) {
+        return;
+    }
+
+    camera.offset = {static_cast<float>(GetRenderWidth()) / 2, static_cast<float>(GetRenderHeight()) / 2};
+
+    //die Kamera bewegt sich nur pro Tick; dazwischen wird interpoliert, damit das Scrollen nicht in Tickschritten ruckelt
+    Camera2D interpolated = camera;
+    interpolated.target = {
+        previousTarget.x + (camera.target.x - previousTarget.x) * partialTick,
+        previousTarget.y + (camera.target.y - previousTarget.y) * partialTick
+    };
+
+    //sichtbarer Bereich in Weltpixeln
+    const Vector2 topLeft = GetScreenToWorld2D({0, 0}, interpolated);
+    const Vector2 bottomRight = GetScreenToWorld2D({static_cast<float>(GetRenderWidth()), static_cast<float>(GetRenderHeight())}, interpolated);
+    const Rectangle view{topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
+
+    //backt in eigene Render-Targets und muss deshalb vor BeginMode2D() laufen
+    tileRenderer.Prepare(*world, view);
+
+    BeginMode2D(interpolated); {
+
+        tileRenderer.Draw();
+
+    } EndMode2D();
+
+}
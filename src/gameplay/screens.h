@@ -3,12 +3,36 @@
 #include "../engine/render.h"
 #include "../engine/assets.h"
 
+#include "world/tilerenderer.h"
+
 class ScreenMainMenu : public Screen {
     public:
         ScreenMainMenu();
         virtual ~ScreenMainMenu() = default;
         virtual void UpdateGameplay() override;
         virtual void RenderScreen(float partialTick) override;
+        virtual void PreloadAssets() override;
     private:
         AssetManager assetManager;
-}; 
\ No newline at end of file
+        TextureRequest background;
+        AtlasSpriteRequest logo;
+};
+
+/**
+ * Zeigt die offene Welt. Öffnet beim Erstellen die Welt aus WORLD_PATH über Sunworld::OpenWorld() und schließt sie beim Zerstören wieder.
+ * Die Kamera wird mit den Pfeiltasten bewegt; um sie herum streamt der ChunkStreamer die Chunks, der TileRenderer zeichnet den sichtbaren Ausschnitt.
+ */
+class ScreenWorld : public Screen {
+    public:
+        static constexpr const char *WORLD_PATH = "world.sww";
+        ScreenWorld();
+        virtual ~ScreenWorld() override;
+        virtual void UpdateGameplay() override;
+        virtual void RenderScreen(float partialTick) override;
+    private:
+        RaylibChunkRenderBackend chunkBackend;
+        TileRenderer tileRenderer;
+        Camera2D camera{};
+        //Kameraziel vor dem letzten Tick, zum Interpolieren zwischen zwei Ticks beim Rendern
+        Vector2 previousTarget{};
+};
@@ -3,35 +3,66 @@
 #include "../../include/raylib.h"
 
 #include "../io/debug.h"
+#include "../io/profiler.h"
+
+#include "world/tiles.h"
+
+#include <filesystem>
 
 namespace Sunworld {
 
     struct {
+        //muss vor allen Benutzern angelegt und nach ihnen zerstört werden
+        TextureAtlas sharedAtlas;
         AssetManager coreAssetManager;
-        FontRenderer fontRenderer{"assets/font/"};
+        FontRenderer fontRenderer{"assets/font/", &sharedAtlas};
         SoundQueue musicQueue;
+        //hält Aliase von Sounds des coreAssetManager und muss deshalb vor ihm zerstört werden
+        SfxPool sfxPool{&coreAssetManager};
+        AnimationSystem animations;
         Screen *screen{nullptr};
+        World *world{nullptr};
+        ChunkSource *chunkSource{nullptr};
+        ChunkStreamer *chunkStreamer{nullptr};
     } State;
 
+    static constexpr const char *ASSET_ARCHIVE = "assets.swpak";
+    static constexpr int CHUNK_LOAD_RADIUS = 4;
+    static constexpr size_t MAX_RESIDENT_CHUNKS = 128;
+
     void Init() {
 
+        //gepackte Assets haben Vorrang; fehlt das Archiv, wird wie bisher aus den losen Dateien geladen
+        if (std::filesystem::exists(ASSET_ARCHIVE)) {
+            AssetManager::MountArchive(ASSET_ARCHIVE, "assets/");
+        }
+
         //alle Suchordner zu coreAssetManager hinzufügen
         {
             State.coreAssetManager.AddSearchDir("assets/");
             State.coreAssetManager.AddSearchDir("assets/music/");
         }
 
+        //Menügrafiken und Schrift teilen sich die Atlasseiten; Kinder des coreAssetManager laden automatisch in denselben Atlas
+        State.coreAssetManager.SetAtlas(&State.sharedAtlas);
+
+        Tiles::RegisterDefaults();
+
         State.screen = new ScreenMainMenu();
+        State.screen->PreloadAssets();
+
+        //die Queue läuft ab hier im Audio-Callback; Musik wird gestreamt, statt beide Stücke komplett dekodiert im Speicher zu halten
+        State.musicQueue.AttachToDevice();
 
         State.musicQueue.QueueLoopingFadeIn(
-            State.coreAssetManager.GetSound("funky.wav").value(),
+            State.coreAssetManager.OpenMusicStream("funky.wav"),
             5000
         );
 
         State.musicQueue.QueueSilence(2500);
 
         State.musicQueue.QueueFadeIn(
-            State.coreAssetManager.GetSound("intro.wav").value(),
+            State.coreAssetManager.OpenMusicStream("intro.wav"),
             5000
         );
         
@@ -40,33 +71,50 @@ namespace Sunworld {
 
     void Update() {
 
+        PROFILE_ZONE("Sunworld::Update");
+
         State.musicQueue.Update();
 
+        State.animations.Advance(1.0f / TICKS_PER_SECOND);
+
         State.screen->UpdateGameplay();
 
     }
 
     void Render(float partialTick) {
 
-        ClearBackground(WHITE);
+        {
+            PROFILE_ZONE("Sunworld::Render");
+
+            ClearBackground(WHITE);
+
+            State.screen->RenderScreen(partialTick);
+        }
+
+        if (Profiler::IsOverlayVisible()) {
 
-        State.screen->RenderScreen(partialTick);
+            Profiler::DrawOverlay(&State.fontRenderer, {10, 10}, 0.5f);
+
+        }
 
     }
 
     void Exit(std::string message) {
 
-        Debug::Log(Debug::LogLevel::FATAL, message.c_str());
+        Debug::Log<Debug::LogLevel::FATAL>(message.c_str());
 
         CloseWindow();
         Shutdown();
 
+        Debug::Flush();
         std::exit(-1);
 
     }
 
     void Shutdown() {
 
+        CloseWorld();
+
     }
 
     void SwitchScreen(Screen *screen, bool transition) {
@@ -84,6 +132,9 @@ namespace Sunworld {
                         this->previous = previous;
                         this->next = next;
 
+                        //der nächste Screen lädt im Hintergrund, während der aktuelle ausgeblendet wird
+                        next->PreloadAssets();
+
                     }
                     virtual ~ScreenTransition() override {
 
@@ -166,6 +217,12 @@ namespace Sunworld {
 
     }
 
+    TextureAtlas *GetSharedAtlas() {
+
+        return &State.sharedAtlas;
+
+    }
+
     FontRenderer *GetFontRenderer() {
 
         return &State.fontRenderer;
@@ -184,4 +241,74 @@ namespace Sunworld {
 
     }
 
+    SfxPool *GetSfxPool() {
+
+        return &State.sfxPool;
+
+    }
+
+    AnimationSystem *GetAnimationSystem() {
+
+        return &State.animations;
+
+    }
+
+    void OpenWorld(ChunkSource *source) {
+
+        CloseWorld();
+
+        State.world = new World();
+        State.chunkSource = source;
+        State.chunkStreamer = new ChunkStreamer(State.world, source, CHUNK_LOAD_RADIUS, MAX_RESIDENT_CHUNKS);
+
+    }
+
+    void CloseWorld() {
+
+        if (State.chunkStreamer != nullptr) {
+
+            State.chunkStreamer->Flush();
+            delete State.chunkStreamer;
+            State.chunkStreamer = nullptr;
+
+        }
+
+        if (State.world != nullptr) {
+
+            delete State.world;
+            State.world = nullptr;
+
+        }
+
+        if (State.chunkSource != nullptr) {
+
+            delete State.chunkSource;
+            State.chunkSource = nullptr;
+
+        }
+
+    }
+
+    void InstallStreamedChunks() {
+
+        if (State.chunkStreamer != nullptr) {
+
+            State.chunkStreamer->InstallFinishedChunks();
+
+        }
+
+    }
+
+    World *GetWorld() {
+
+        return State.world;
+
+    }
+
+    ChunkStreamer *GetChunkStreamer() {
+
+        return State.chunkStreamer;
+
+    }
+
 }
\ No newline at end of file
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "../engine/animation.h"
 #include "../engine/assets.h"
+#include "../engine/sfx.h"
 
 #include "screens.h"
+#include "world/world.h"
+#include "world/streaming.h"
 
 namespace Sunworld {
 
+    inline constexpr int TICKS_PER_SECOND = 20;
+
     void Init();
 
     void Update();
@@ -27,10 +33,48 @@ namespace Sunworld {
      */
     void SwitchScreen(Screen *screen, bool transition = true);
 
+    /**
+     * Der Atlas für Schrift und Menügrafiken, siehe AssetManager::RequestAtlasSprite().
+     */
+    TextureAtlas *GetSharedAtlas();
+
     FontRenderer *GetFontRenderer();
 
     AssetManager *GetCoreAssetManager();
 
     SoundQueue *GetMainSoundQueue();
 
+    /**
+     * Für kurze, sich überlagernde Soundeffekte. Sounds vorher mit Preload() anmelden.
+     */
+    SfxPool *GetSfxPool();
+
+    /**
+     * Wird einmal pro Tick in Update() weitergezählt. Für Kacheln, die synchron laufen sollen, GetShared() benutzen.
+     */
+    AnimationSystem *GetAnimationSystem();
+
+    /**
+     * Öffnet eine Welt, deren Chunks aus source gestreamt werden. Eine eventuell offene Welt wird vorher geschlossen.
+     * Ownership des ChunkSource-Zeigers wird an diese Funktion übergeben.
+     */
+    void OpenWorld(ChunkSource *source);
+
+    /**
+     * Schreibt alle veränderten Chunks zurück und schließt die aktuelle Welt.
+     */
+    void CloseWorld();
+
+    /**
+     * Übernimmt vom Streaming-Thread fertig geladene Chunks in die Welt. Wird in main() zwischen den Updates aufgerufen.
+     */
+    void InstallStreamedChunks();
+
+    /**
+     * Gibt die aktuelle Welt zurück, oder nullptr wenn keine Welt offen ist.
+     */
+    World *GetWorld();
+
+    ChunkStreamer *GetChunkStreamer();
+
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "streaming.h"
+
+#include "../../io/debug.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+ChunkStreamer::ChunkStreamer(World *world, ChunkSource *source, int loadRadius, size_t maxResidentChunks)
+: world(world), source(source), loadRadius(loadRadius), maxResidentChunks(maxResidentChunks)
+{
+
+    worker = std::thread(&ChunkStreamer::WorkerLoop, this);
+
+}
+
+ChunkStreamer::~ChunkStreamer() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        //ausstehende Ladeaufträge sind jetzt egal, Speicheraufträge müssen aber noch abgearbeitet werden
+        std::erase_if(jobs, [](const Job& job) { return job.chunkToSave == nullptr; });
+        stop = true;
+    }
+
+    jobAvailable.notify_all();
+    worker.join();
+
+}
+
+bool ChunkStreamer::IsInRange(ChunkPos pos, int radius) const {
+
+    return std::abs(pos.x - center.x) <= radius && std::abs(pos.y - center.y) <= radius;
+
+}
+
+void ChunkStreamer::SetCenter(ChunkPos newCenter) {
+
+    if (hasCenter && newCenter == center) {
+        return;
+    }
+
+    center = newCenter;
+    hasCenter = true;
+
+    //Chunks knapp außerhalb des Laderadius bleiben noch geladen, damit ein Hin- und Herlaufen an der Grenze nicht ständig lädt und entlädt.
+    const int unloadRadius = loadRadius + 1;
+
+    std::vector<ChunkPos> toEvict;
+    for (const auto& [pos, chunk] : world->GetChunks()) {
+
+        if (!IsInRange(pos, unloadRadius)) {
+            toEvict.push_back(pos);
+        }
+
+    }
+
+    for (const ChunkPos pos : toEvict) {
+        Evict(pos);
+    }
+
+    //noch nicht angefangene Ladeaufträge für Chunks, die schon wieder außerhalb liegen, würden nur geladen und gleich verworfen
+    //und bis dahin das Budget belegen. Speicheraufträge müssen dagegen immer ausgeführt werden.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::erase_if(jobs, [this, unloadRadius](const Job& job) {
+
+            if (job.chunkToSave != nullptr || IsInRange(job.pos, unloadRadius)) {
+                return false;
+            }
+
+            pending.erase(job.pos);
+            return true;
+
+        });
+    }
+
+    std::vector<ChunkPos> wanted;
+    for (int y = center.y - loadRadius; y <= center.y + loadRadius; ++y) {
+        for (int x = center.x - loadRadius; x <= center.x + loadRadius; ++x) {
+
+            const ChunkPos pos{x, y};
+            if (world->GetChunk(pos) == nullptr && !pending.contains(pos)) {
+                wanted.push_back(pos);
+            }
+
+        }
+    }
+
+    const auto distance = [this](ChunkPos pos) {
+        const int dx = pos.x - center.x;
+        const int dy = pos.y - center.y;
+        return dx*dx + dy*dy;
+    };
+
+    std::sort(wanted.begin(), wanted.end(), [&distance](ChunkPos a, ChunkPos b) {
+        return distance(a) < distance(b);
+    });
+
+    //Budget einhalten: weiter entfernte geladene Chunks werden verdrängt, solange sie weiter weg sind als der angeforderte.
+    for (const ChunkPos pos : wanted) {
+
+        if (world->GetChunkCount() + pending.size() >= maxResidentChunks) {
+
+            ChunkPos farthest{};
+            int farthestDistance = -1;
+            for (const auto& [residentPos, chunk] : world->GetChunks()) {
+
+                if (distance(residentPos) > farthestDistance) {
+                    farthestDistance = distance(residentPos);
+                    farthest = residentPos;
+                }
+
+            }
+
+            if (farthestDistance <= distance(pos)) {
+                break;
+            }
+
+            Evict(farthest);
+
+        }
+
+        pending.insert(pos);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({pos, nullptr});
+        }
+
+    }
+
+    jobAvailable.notify_one();
+
+}
+
+void ChunkStreamer::Evict(ChunkPos pos) {
+
+    std::unique_ptr<Chunk> chunk = world->RemoveChunk(pos);
+
+    if (chunk == nullptr || !chunk->modified || source == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({pos, std::move(chunk)});
+    }
+
+    jobAvailable.notify_one();
+
+}
+
+void ChunkStreamer::InstallFinishedChunks() {
+
+    std::vector<std::unique_ptr<Chunk>> done;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (finished.empty()) {
+            return;
+        }
+        done.swap(finished);
+    }
+
+    for (std::unique_ptr<Chunk>& chunk : done) {
+
+        const ChunkPos pos = chunk->pos;
+        pending.erase(pos);
+
+        //in der Zwischenzeit aus dem Radius gewandert: unverändert, also einfach verwerfen
+        if (!IsInRange(pos, loadRadius + 1)) {
+            continue;
+        }
+
+        world->InsertChunk(std::move(chunk));
+
+    }
+
+}
+
+void ChunkStreamer::Flush() {
+
+    std::vector<ChunkPos> resident;
+    for (const auto& [pos, chunk] : world->GetChunks()) {
+        resident.push_back(pos);
+    }
+
+    if (source != nullptr) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const ChunkPos pos : resident) {
+
+            Chunk *chunk = world->GetChunk(pos);
+            if (!chunk->modified) {
+                continue;
+            }
+
+            //Kopie, damit der Chunk geladen bleiben kann während er gespeichert wird
+            jobs.push_back({pos, std::make_unique<Chunk>(*chunk)});
+            chunk->modified = false;
+
+        }
+
+    }
+
+    jobAvailable.notify_one();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return jobs.empty() && !busy; });
+
+}
+
+size_t ChunkStreamer::GetPendingCount() const {
+
+    return pending.size();
+
+}
+
+void ChunkStreamer::WorkerLoop() {
+
+    while (true) {
+
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stop || !jobs.empty(); });
+
+            if (jobs.empty()) {
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+        }
+
+        std::unique_ptr<Chunk> loaded;
+
+        if (job.chunkToSave != nullptr) {
+
+            source->SaveChunk(*job.chunkToSave);
+
+        } else {
+
+            if (source != nullptr) {
+                loaded = source->LoadChunk(job.pos);
+            }
+
+            if (loaded == nullptr) {
+                loaded = std::make_unique<Chunk>(job.pos);
+            }
+
+            loaded->modified = false;
+
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (loaded != nullptr) {
+                finished.push_back(std::move(loaded));
+            }
+            busy = false;
+        }
+
+        idle.notify_all();
+
+    }
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "world.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Quelle, aus der Chunks geladen und in die veränderte Chunks beim Entladen zurückgeschrieben werden.
+ * Wird ausschließlich vom Worker-Thread des ChunkStreamers aufgerufen.
+ */
+class ChunkSource {
+    public:
+        virtual ~ChunkSource() = default;
+        /**
+         * Lädt einen Chunk. nullptr bedeutet, dass der Chunk noch nicht existiert; der Streamer legt dann einen leeren Chunk an.
+         */
+        virtual std::unique_ptr<Chunk> LoadChunk(ChunkPos pos) = 0;
+        virtual void SaveChunk(const Chunk& chunk) = 0;
+};
+
+/**
+ * Lädt Chunks um ein Zentrum (normalerweise die Kamera) asynchron nach und entlädt weit entfernte Chunks.
+ *
+ * Laden und Speichern passiert auf einem eigenen Worker-Thread. Der Main-Thread fasst die World nur in SetCenter() und InstallFinishedChunks() an,
+ * die World selbst muss also nicht threadsicher sein.
+ */
+class ChunkStreamer final {
+    public:
+        /**
+         * Ownership von source bleibt beim Caller, source muss den Streamer überleben. Ist source nullptr, werden alle Chunks leer erzeugt und beim Entladen verworfen.
+         * maxResidentChunks begrenzt die Anzahl gleichzeitig geladener (und angeforderter) Chunks; die am weitesten entfernten werden zuerst entladen.
+         */
+        ChunkStreamer(World *world, ChunkSource *source, int loadRadius, size_t maxResidentChunks);
+        ~ChunkStreamer();
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        /**
+         * Setzt das Zentrum in Chunk-Koordinaten. Fordert fehlende Chunks im Laderadius an (nächste zuerst) und gibt Chunks außerhalb an den Worker zum Speichern.
+         */
+        void SetCenter(ChunkPos center);
+        /**
+         * Übernimmt fertig geladene Chunks in die World. Muss auf dem Main-Thread zwischen zwei Updates aufgerufen werden.
+         */
+        void InstallFinishedChunks();
+        /**
+         * Schreibt alle geladenen, veränderten Chunks zurück und wartet bis der Worker fertig ist.
+         */
+        void Flush();
+        size_t GetPendingCount() const;
+    private:
+        struct Job {
+            ChunkPos pos;
+            //nullptr = Chunk laden, sonst Chunk speichern
+            std::unique_ptr<Chunk> chunkToSave;
+        };
+        void WorkerLoop();
+        void Evict(ChunkPos pos);
+        bool IsInRange(ChunkPos pos, int radius) const;
+        World *world;
+        ChunkSource *source;
+        int loadRadius;
+        size_t maxResidentChunks;
+        ChunkPos center{0, 0};
+        bool hasCenter = false;
+        //nur vom Main-Thread benutzt
+        std::unordered_set<ChunkPos, ChunkPosHash> pending;
+
+        std::thread worker;
+        mutable std::mutex mutex;
+        std::condition_variable jobAvailable;
+        std::condition_variable idle;
+        std::deque<Job> jobs;
+        std::vector<std::unique_ptr<Chunk>> finished;
+        bool busy = false;
+        bool stop = false;
+};
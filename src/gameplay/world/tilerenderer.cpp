@@ -0,0 +1,255 @@
+#include "tilerenderer.h"
+
+#include <cmath>
+
+bool ChunkRange::Contains(ChunkPos pos) const {
+
+    return pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY;
+
+}
+
+ChunkRange ComputeVisibleChunks(Rectangle view) {
+
+    const float chunkSize = static_cast<float>(CHUNK_PIXEL_SIZE);
+
+    //die rechte/untere Kante selbst gehört nicht mehr zum sichtbaren Bereich
+    return {
+        static_cast<int>(std::floor(view.x / chunkSize)),
+        static_cast<int>(std::floor(view.y / chunkSize)),
+        static_cast<int>(std::ceil((view.x + view.width) / chunkSize)) - 1,
+        static_cast<int>(std::ceil((view.y + view.height) / chunkSize)) - 1
+    };
+
+}
+
+/**
+ * RaylibChunkRenderBackend class
+ */
+
+RaylibChunkRenderBackend::RaylibChunkRenderBackend(AssetManager *assetManager) : assetManager(assetManager) {}
+
+RenderTexture2D RaylibChunkRenderBackend::CreateTarget() {
+
+    return LoadRenderTexture(CHUNK_PIXEL_SIZE, CHUNK_PIXEL_SIZE);
+
+}
+
+Texture2D RaylibChunkRenderBackend::GetTileTexture(TileID id) {
+
+    std::optional<TextureHandle>& cached = tileTextures[id];
+
+    if (!cached.has_value()) {
+
+        const TileDefinition& def = Tiles::Get(id);
+
+        //ein ungültiges Handle liefert eine leere Textur, die beim Backen übersprungen wird
+        if (def.texture.empty()) {
+            cached = TextureHandle();
+        } else {
+            cached = assetManager->AcquireTexture(def.texture).value_or(TextureHandle());
+        }
+
+    }
+
+    return cached->Get();
+
+}
+
+void RaylibChunkRenderBackend::Bake(RenderTexture2D target, const Chunk& chunk) {
+
+    static constexpr Color BACKGROUND_TINT{140, 140, 140, 255};
+    //der Hintergrund liegt eine Ebene unter dem Vordergrund, damit er durch teilweise transparente Tiles durchscheint
+    static constexpr int BACKGROUND_LAYER = 0;
+    static constexpr int FOREGROUND_LAYER = 1;
+    static constexpr Rectangle SOURCE{0, 0, TILE_SIZE, TILE_SIZE};
+
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+
+    for (int y = 0; y < CHUNK_SIZE; ++y) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+
+            const int index = y * CHUNK_SIZE + x;
+            const Rectangle dest{static_cast<float>(x * TILE_SIZE), static_cast<float>(y * TILE_SIZE), TILE_SIZE, TILE_SIZE};
+
+            const TileID frontId = chunk.foreground[index];
+            const Texture2D front = GetTileTexture(frontId);
+            if (front.id != 0) {
+
+                batch.Draw(front, SOURCE, dest, WHITE, FOREGROUND_LAYER);
+
+                //nur ein deckendes Vordergrundtile verdeckt den Hintergrund ganz
+                if (Tiles::IsOpaque(frontId)) {
+                    continue;
+                }
+
+            }
+
+            const Texture2D back = GetTileTexture(chunk.background[index]);
+            if (back.id != 0) {
+                batch.Draw(back, SOURCE, dest, BACKGROUND_TINT, BACKGROUND_LAYER);
+            }
+
+        }
+    }
+
+    //erst alle Hintergrundtiles, dann alle Vordergrundtiles, innerhalb einer Ebene ein Draw Call pro Tileart
+    batch.Flush();
+
+    EndTextureMode();
+
+}
+
+void RaylibChunkRenderBackend::Draw(RenderTexture2D target, Rectangle dest) {
+
+    //RenderTextures liegen in OpenGL auf dem Kopf, deshalb negative Höhe im Quellrechteck
+    const Rectangle sourceRec{0, 0, static_cast<float>(target.texture.width), -static_cast<float>(target.texture.height)};
+    constexpr Vector2 origin{0, 0};
+    constexpr float rotation{0};
+    constexpr Color NO_TINT = WHITE;
+
+    DrawTexturePro(target.texture, sourceRec, dest, origin, rotation, NO_TINT);
+
+}
+
+void RaylibChunkRenderBackend::Release(RenderTexture2D target) {
+
+    UnloadRenderTexture(target);
+
+}
+
+uint64_t RaylibChunkRenderBackend::GetTextureGeneration() {
+
+    return AssetManager::GetReloadGeneration();
+
+}
+
+/**
+ * TileRenderer class
+ */
+
+TileRenderer::TileRenderer(ChunkRenderBackend *backend) : backend(backend) {}
+
+TileRenderer::~TileRenderer() {
+
+    Clear();
+
+}
+
+void TileRenderer::Prepare(const World& world, Rectangle view) {
+
+    ++frame;
+    bakesLastFrame = 0;
+    visible.clear();
+
+    //eine Tiletextur wurde neu geladen: alle Chunks neu backen (serial 0 gehört zu keinem Chunk)
+    const uint64_t generation = backend->GetTextureGeneration();
+    if (bakedGeneration != generation) {
+
+        for (auto& [pos, cached] : cache) {
+            cached.serial = 0;
+        }
+        bakedGeneration = generation;
+
+    }
+
+    const ChunkRange range = ComputeVisibleChunks(view);
+
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+
+            const ChunkPos pos{x, y};
+            const Chunk *chunk = world.GetChunk(pos);
+
+            if (chunk == nullptr) {
+                continue;
+            }
+
+            auto it = cache.find(pos);
+            if (it == cache.end()) {
+                it = cache.emplace(pos, CachedChunk{backend->CreateTarget(), 0, 0, frame}).first;
+            }
+
+            CachedChunk& cached = it->second;
+            cached.lastVisibleFrame = frame;
+
+            if (cached.serial != chunk->serial || cached.revision != chunk->revision) {
+
+                backend->Bake(cached.target, *chunk);
+                cached.serial = chunk->serial;
+                cached.revision = chunk->revision;
+                ++bakesLastFrame;
+
+            }
+
+            visible.push_back(pos);
+
+        }
+    }
+
+    //nicht mehr sichtbare Chunks noch eine Weile behalten, damit kurzes Hin- und Herscrollen nicht ständig neu backt
+    for (auto it = cache.begin(); it != cache.end();) {
+
+        if (frame - it->second.lastVisibleFrame > CACHE_GRACE_FRAMES) {
+
+            backend->Release(it->second.target);
+            it = cache.erase(it);
+
+        } else {
+
+            ++it;
+
+        }
+
+    }
+
+}
+
+void TileRenderer::Draw() {
+
+    drawsLastFrame = 0;
+
+    for (const ChunkPos pos : visible) {
+
+        const Rectangle dest{
+            static_cast<float>(pos.x * CHUNK_PIXEL_SIZE),
+            static_cast<float>(pos.y * CHUNK_PIXEL_SIZE),
+            static_cast<float>(CHUNK_PIXEL_SIZE),
+            static_cast<float>(CHUNK_PIXEL_SIZE)
+        };
+
+        backend->Draw(cache.at(pos).target, dest);
+        ++drawsLastFrame;
+
+    }
+
+}
+
+void TileRenderer::Clear() {
+
+    for (auto& [pos, cached] : cache) {
+        backend->Release(cached.target);
+    }
+
+    cache.clear();
+    visible.clear();
+
+}
+
+size_t TileRenderer::GetCachedChunkCount() const {
+
+    return cache.size();
+
+}
+
+size_t TileRenderer::GetBakesLastFrame() const {
+
+    return bakesLastFrame;
+
+}
+
+size_t TileRenderer::GetDrawsLastFrame() const {
+
+    return drawsLastFrame;
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "world.h"
+
+#include "../../engine/assets.h"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+
+inline constexpr int TILE_SIZE = 16;
+inline constexpr int CHUNK_PIXEL_SIZE = CHUNK_SIZE * TILE_SIZE;
+
+/**
+ * Inklusiver Bereich von Chunk-Koordinaten.
+ */
+struct ChunkRange {
+    int minX, minY;
+    int maxX, maxY;
+
+    bool Contains(ChunkPos pos) const;
+};
+
+/**
+ * Berechnet alle Chunks, die ein Rechteck in Weltpixeln (z.B. der sichtbare Kamerabereich) schneidet.
+ */
+ChunkRange ComputeVisibleChunks(Rectangle view);
+
+/**
+ * Alles, was der TileRenderer an der GPU macht. Der Renderer selbst enthält nur Culling- und Cache-Logik, sodass diese mit einem Backend ohne GPU getestet werden kann.
+ */
+class ChunkRenderBackend {
+    public:
+        virtual ~ChunkRenderBackend() = default;
+        virtual RenderTexture2D CreateTarget() = 0;
+        virtual void Bake(RenderTexture2D target, const Chunk& chunk) = 0;
+        virtual void Draw(RenderTexture2D target, Rectangle dest) = 0;
+        virtual void Release(RenderTexture2D target) = 0;
+        /**
+         * Ändert sich der Wert, sind alle gebackenen Chunks veraltet (z.B. weil eine Tiletextur neu geladen wurde).
+         */
+        virtual uint64_t GetTextureGeneration() = 0;
+};
+
+/**
+ * Standard-Backend: backt die Tiles eines Chunks über raylib in eine RenderTexture. Die Texturen der Tiles werden über den AssetManager aufgelöst und pro TileID zwischengespeichert.
+ */
+class RaylibChunkRenderBackend final : public ChunkRenderBackend {
+    public:
+        RaylibChunkRenderBackend(AssetManager *assetManager);
+        virtual RenderTexture2D CreateTarget() override;
+        virtual void Bake(RenderTexture2D target, const Chunk& chunk) override;
+        virtual void Draw(RenderTexture2D target, Rectangle dest) override;
+        virtual void Release(RenderTexture2D target) override;
+        /**
+         * AssetManager::GetReloadGeneration().
+         */
+        virtual uint64_t GetTextureGeneration() override;
+    private:
+        Texture2D GetTileTexture(TileID id);
+        AssetManager *assetManager;
+        //Handles statt Rohwerten: wird das Backend zerstört, dürfen die Texturen wieder verdrängt werden
+        std::array<std::optional<TextureHandle>, 256> tileTextures;
+        //sortiert die Tiles eines Chunks nach Textur, ein Draw Call pro Tileart statt einer pro Tile
+        SpriteBatch batch;
+};
+
+/**
+ * Zeichnet den sichtbaren Ausschnitt einer World. Jeder Chunk wird einmal in eine eigene RenderTexture gebacken und danach als ein einziges Quad gezeichnet.
+ * Neu gebacken wird nur, wenn sich ein Tile im Chunk geändert hat (Chunk::revision) oder der Chunk neu geladen wurde (Chunk::serial).
+ *
+ * Ablauf pro Frame: Prepare() vor BeginMode2D() (Backen benutzt eigene Render-Targets), danach Draw() innerhalb von BeginMode2D().
+ */
+class TileRenderer final {
+    public:
+        /**
+         * Ownership des Backends bleibt beim Caller.
+         */
+        TileRenderer(ChunkRenderBackend *backend);
+        ~TileRenderer();
+        TileRenderer(const TileRenderer&) = delete;
+        TileRenderer& operator=(const TileRenderer&) = delete;
+        /**
+         * Bestimmt die sichtbaren Chunks, backt veraltete neu und gibt Cache-Einträge frei, die länger als CACHE_GRACE_FRAMES nicht sichtbar waren.
+         */
+        void Prepare(const World& world, Rectangle view);
+        /**
+         * Zeichnet alle in Prepare() ermittelten Chunks, ein Quad pro Chunk.
+         */
+        void Draw();
+        /**
+         * Gibt alle gebackenen Texturen frei.
+         */
+        void Clear();
+        size_t GetCachedChunkCount() const;
+        size_t GetBakesLastFrame() const;
+        size_t GetDrawsLastFrame() const;
+        static constexpr unsigned int CACHE_GRACE_FRAMES = 120;
+    private:
+        struct CachedChunk {
+            RenderTexture2D target;
+            uint64_t serial;
+            uint32_t revision;
+            unsigned int lastVisibleFrame;
+        };
+        ChunkRenderBackend *backend;
+        std::unordered_map<ChunkPos, CachedChunk, ChunkPosHash> cache;
+        std::vector<ChunkPos> visible;
+        unsigned int frame = 0;
+        uint64_t bakedGeneration = 0;
+        size_t bakesLastFrame = 0;
+        size_t drawsLastFrame = 0;
+};
@@ -1,14 +1,88 @@
 #include "tiles.h"
 
-#include "../../engine/allocator.h"
+#include "../../io/debug.h"
 
-#include <unordered_map>
+#include <array>
 
-void MakeTile() {
+namespace Tiles {
 
-    static ArenaAllocator<sizeof(_Tile)*255> tileAllocator;
+    struct {
+        std::array<TileDefinition, MAX_TILES> definitions;
+        std::array<bool, MAX_TILES> registered{};
+        //Heiße Eigenschaften liegen zusätzlich in eigenen Arrays, damit Kollisions- und Lichtabfragen nicht die ganze Definition in den Cache ziehen.
+        std::array<bool, MAX_TILES> solid{};
+        std::array<bool, MAX_TILES> opaque{};
+        std::array<unsigned char, MAX_TILES> lightEmission{};
+    } Registry;
 
-    Tile t = tileAllocator.Alloc<_Tile>();
+    bool Register(const TileDefinition& def) {
 
-    return t;
-}
\ No newline at end of file
+        if (def.id == INVALID_TILE_ID) {
+
+            Debug::Log<Debug::LogLevel::ERROR>("Cannot register tile '%s' with INVALID_TILE_ID.", def.name.c_str());
+            return false;
+
+        }
+
+        if (Registry.registered[def.id]) {
+
+            Debug::Log<Debug::LogLevel::ERROR>("Tile id %i is already registered as '%s', cannot register '%s'.", def.id, Registry.definitions[def.id].name.c_str(), def.name.c_str());
+            return false;
+
+        }
+
+        Registry.definitions[def.id] = def;
+        Registry.registered[def.id] = true;
+        Registry.solid[def.id] = def.solid;
+        Registry.opaque[def.id] = def.opaque;
+        Registry.lightEmission[def.id] = def.lightEmission;
+
+        return true;
+
+    }
+
+    void RegisterDefaults() {
+
+        TileDefinition air;
+        air.id = AIR_TILE_ID;
+        air.name = "air";
+        air.solid = false;
+        Register(air);
+
+    }
+
+    bool IsRegistered(TileID id) {
+
+        return Registry.registered[id];
+
+    }
+
+    const TileDefinition& Get(TileID id) {
+
+        if (!Registry.registered[id]) {
+            return Registry.definitions[AIR_TILE_ID];
+        }
+
+        return Registry.definitions[id];
+
+    }
+
+    bool IsSolid(TileID id) {
+
+        return Registry.solid[id];
+
+    }
+
+    bool IsOpaque(TileID id) {
+
+        return Registry.opaque[id];
+
+    }
+
+    unsigned char GetLightEmission(TileID id) {
+
+        return Registry.lightEmission[id];
+
+    }
+
+}
@@ -1,20 +1,65 @@
 #pragma once
 
-using TileID = char;
-inline constexpr TileID INVALID_TILE_ID = -1;
+#include "../../../include/raylib.h"
 
-class _Tile {
+#include <cstddef>
+#include <string>
 
-    private:
-        TileID id = INVALID_TILE_ID;
+using TileID = unsigned char;
+inline constexpr TileID INVALID_TILE_ID = 255;
+inline constexpr TileID AIR_TILE_ID = 0;
+
+/**
+ * Unveränderliche Beschreibung eines Tile-Typs. Pro TileID gibt es genau eine Definition, die Welt selbst speichert nur die 1-Byte TileIDs.
+ */
+struct TileDefinition {
+    TileID id = INVALID_TILE_ID;
+    std::string name;
+    bool solid = false;
+    /**
+     * Ob die Textur ihre Zelle vollständig und ohne Transparenz abdeckt. Nur dann wird der Hintergrund hinter dem Tile nicht gezeichnet.
+     */
+    bool opaque = false;
+    /**
+     * Asset-Identifier der Textur. Leer bedeutet, dass das Tile nicht gezeichnet wird.
+     */
+    std::string texture;
+    /**
+     * Asset-Identifier einer .ani Datei. Leer bedeutet, dass das Tile nicht animiert ist.
+     */
+    std::string animation;
+    unsigned char lightEmission = 0;
+    Color lightColor{255, 255, 255, 255};
 };
 
-using Tile = _Tile*;
+/**
+ * Registry aller Tile-Typen. Alle Eigenschaften liegen in dichten, über die TileID indizierten Tabellen, sodass Renderer und Kollisionsabfrage mit einem einzigen Arrayzugriff auskommen.
+ */
+namespace Tiles {
+
+    inline constexpr size_t MAX_TILES = 256;
 
-Tile MakeTile();
+    /**
+     * Registriert eine Tile-Definition unter def.id. Eine bereits registrierte TileID kann nicht überschrieben werden.
+     */
+    bool Register(const TileDefinition& def);
 
-namespace Tiles {
+    /**
+     * Registriert alle eingebauten Tiles. Wird in Sunworld::Init() aufgerufen.
+     */
+    void RegisterDefaults();
+
+    bool IsRegistered(TileID id);
+
+    /**
+     * Gibt die Definition zu einer TileID zurück. Für nicht registrierte IDs wird die Definition von AIR_TILE_ID zurückgegeben.
+     */
+    const TileDefinition& Get(TileID id);
+
+    bool IsSolid(TileID id);
 
+    bool IsOpaque(TileID id);
 
+    unsigned char GetLightEmission(TileID id);
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,137 @@
+#include "world.h"
+
+/**
+ * Chunk struct
+ */
+
+Chunk::Chunk(ChunkPos pos) : pos(pos) {
+
+    foreground.fill(AIR_TILE_ID);
+    background.fill(AIR_TILE_ID);
+
+}
+
+std::array<TileID, CHUNK_AREA>& Chunk::Layer(TileLayer layer) {
+
+    return layer == TileLayer::FOREGROUND ? foreground : background;
+
+}
+
+const std::array<TileID, CHUNK_AREA>& Chunk::Layer(TileLayer layer) const {
+
+    return layer == TileLayer::FOREGROUND ? foreground : background;
+
+}
+
+/**
+ * World class
+ */
+
+ChunkPos World::ToChunkPos(int x, int y) {
+
+    //arithmetischer Shift rundet auch für negative Koordinaten korrekt nach unten ab
+    return {x >> CHUNK_SHIFT, y >> CHUNK_SHIFT};
+
+}
+
+int World::ToLocalIndex(int x, int y) {
+
+    return (y & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (x & (CHUNK_SIZE - 1));
+
+}
+
+Chunk *World::GetChunk(ChunkPos pos) const {
+
+    if (lastChunk != nullptr && lastChunk->pos == pos) {
+        return lastChunk;
+    }
+
+    const auto it = chunks.find(pos);
+    if (it == chunks.end()) {
+        return nullptr;
+    }
+
+    lastChunk = it->second.get();
+    return lastChunk;
+
+}
+
+TileID World::GetTile(int x, int y, TileLayer layer) const {
+
+    const Chunk *chunk = GetChunk(ToChunkPos(x, y));
+
+    if (chunk == nullptr) {
+        return INVALID_TILE_ID;
+    }
+
+    return chunk->Layer(layer)[ToLocalIndex(x, y)];
+
+}
+
+bool World::SetTile(int x, int y, TileID id, TileLayer layer) {
+
+    Chunk *chunk = GetChunk(ToChunkPos(x, y));
+
+    if (chunk == nullptr) {
+        return false;
+    }
+
+    chunk->Layer(layer)[ToLocalIndex(x, y)] = id;
+    chunk->modified = true;
+    ++chunk->revision;
+    return true;
+
+}
+
+Chunk *World::CreateChunk(ChunkPos pos) {
+
+    Chunk *existing = GetChunk(pos);
+    if (existing != nullptr) {
+        return existing;
+    }
+
+    return InsertChunk(std::make_unique<Chunk>(pos));
+
+}
+
+Chunk *World::InsertChunk(std::unique_ptr<Chunk> chunk) {
+
+    const ChunkPos pos = chunk->pos;
+    chunk->serial = nextSerial++;
+    std::unique_ptr<Chunk>& slot = chunks[pos];
+    slot = std::move(chunk);
+
+    lastChunk = slot.get();
+    return lastChunk;
+
+}
+
+std::unique_ptr<Chunk> World::RemoveChunk(ChunkPos pos) {
+
+    const auto it = chunks.find(pos);
+    if (it == chunks.end()) {
+        return nullptr;
+    }
+
+    if (lastChunk == it->second.get()) {
+        lastChunk = nullptr;
+    }
+
+    std::unique_ptr<Chunk> chunk = std::move(it->second);
+    chunks.erase(it);
+
+    return chunk;
+
+}
+
+size_t World::GetChunkCount() const {
+
+    return chunks.size();
+
+}
+
+const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash>& World::GetChunks() const {
+
+    return chunks;
+
+}
@@ -1 +1,104 @@
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include "tiles.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+inline constexpr int CHUNK_SHIFT = 5;
+inline constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+inline constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
+
+enum class TileLayer {
+
+    FOREGROUND, BACKGROUND
+
+};
+
+struct ChunkPos {
+    int x;
+    int y;
+
+    bool operator==(const ChunkPos& other) const = default;
+};
+
+struct ChunkPosHash {
+    size_t operator()(const ChunkPos& pos) const {
+        const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) << 32) | static_cast<uint32_t>(pos.y);
+        return std::hash<uint64_t>{}(key);
+    }
+};
+
+/**
+ * Ein Chunk speichert CHUNK_SIZE x CHUNK_SIZE Tiles als struct-of-arrays: pro Ebene ein zusammenhängendes Array aus TileIDs, zeilenweise angeordnet (Index = y * CHUNK_SIZE + x).
+ * Dadurch liegt beim Durchlaufen einer Zeile alles direkt hintereinander im Speicher.
+ */
+struct Chunk {
+    ChunkPos pos;
+    std::array<TileID, CHUNK_AREA> foreground;
+    std::array<TileID, CHUNK_AREA> background;
+    /**
+     * Wird von World::SetTile gesetzt, damit beim Entladen nur veränderte Chunks zurückgeschrieben werden.
+     */
+    bool modified = false;
+    /**
+     * Wird bei jeder Änderung erhöht. Zusammen mit serial können Caches (z.B. der TileRenderer) erkennen, ob ihr Stand veraltet ist.
+     */
+    uint32_t revision = 0;
+    /**
+     * Von der World beim Einfügen vergeben und innerhalb einer World eindeutig, damit ein neu geladener Chunk an derselben Position als anderer Chunk erkannt wird.
+     */
+    uint64_t serial = 0;
+
+    explicit Chunk(ChunkPos pos);
+    std::array<TileID, CHUNK_AREA>& Layer(TileLayer layer);
+    const std::array<TileID, CHUNK_AREA>& Layer(TileLayer layer) const;
+};
+
+/**
+ * Die Tile-Welt. Besteht aus beliebig vielen Chunks, die über ihre Chunk-Koordinate in einer Hashmap liegen.
+ * Zugriffe über Weltkoordinaten (in Tiles) sind O(1): eine Shift-Operation für die Chunk-Koordinate, eine Maske für den Index innerhalb des Chunks.
+ */
+class World final {
+    public:
+        World() = default;
+        ~World() = default;
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+        /**
+         * Gibt die TileID an der Weltkoordinate zurück. Ist der Chunk nicht geladen, wird INVALID_TILE_ID zurückgegeben.
+         */
+        TileID GetTile(int x, int y, TileLayer layer = TileLayer::FOREGROUND) const;
+        /**
+         * Setzt die TileID an der Weltkoordinate. Gibt false zurück, wenn der Chunk nicht geladen ist.
+         */
+        bool SetTile(int x, int y, TileID id, TileLayer layer = TileLayer::FOREGROUND);
+        /**
+         * Gibt den Chunk an der Chunk-Koordinate zurück, oder nullptr wenn dieser nicht geladen ist.
+         */
+        Chunk *GetChunk(ChunkPos pos) const;
+        /**
+         * Erstellt einen leeren (mit AIR_TILE_ID gefüllten) Chunk. Existiert der Chunk bereits, wird der vorhandene zurückgegeben.
+         */
+        Chunk *CreateChunk(ChunkPos pos);
+        /**
+         * Übernimmt einen fertigen Chunk. Ein eventuell vorhandener Chunk an derselben Position wird ersetzt.
+         */
+        Chunk *InsertChunk(std::unique_ptr<Chunk> chunk);
+        /**
+         * Entfernt einen Chunk und gibt ihn an den Caller zurück (z.B. zum Speichern), oder nullptr wenn dieser nicht geladen war.
+         */
+        std::unique_ptr<Chunk> RemoveChunk(ChunkPos pos);
+        size_t GetChunkCount() const;
+        const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash>& GetChunks() const;
+        static ChunkPos ToChunkPos(int x, int y);
+        static int ToLocalIndex(int x, int y);
+    private:
+        std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> chunks;
+        //Zugriffe sind meistens räumlich zusammenhängend, deshalb wird der zuletzt benutzte Chunk zwischengespeichert und der Hashmap-Lookup übersprungen.
+        mutable Chunk *lastChunk = nullptr;
+        uint64_t nextSerial = 1;
+};
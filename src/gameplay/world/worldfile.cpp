@@ -0,0 +1,500 @@
+#include "worldfile.h"
+
+#include "../../io/debug.h"
+
+#include <cstring>
+#include <filesystem>
+
+static constexpr char WORLD_MAGIC[4] = {'S', 'W', 'W', 'D'};
+static constexpr size_t HEADER_SIZE = 16;
+static constexpr size_t INDEX_ENTRY_SIZE = 24;
+static constexpr uint32_t INITIAL_INDEX_CAPACITY = 256;
+static constexpr size_t RAW_CHUNK_SIZE = 2 * CHUNK_AREA;
+
+enum ChunkEncoding : unsigned char {
+    RAW = 0,
+    RLE = 1
+};
+
+template<typename T>
+static T ReadLE(const unsigned char *p) {
+
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+
+}
+
+template<typename T>
+static void WriteLE(unsigned char *p, T value) {
+
+    std::memcpy(p, &value, sizeof(T));
+
+}
+
+static std::vector<unsigned char> EncodeChunk(const Chunk& chunk) {
+
+    unsigned char raw[RAW_CHUNK_SIZE];
+    std::memcpy(raw, chunk.foreground.data(), CHUNK_AREA);
+    std::memcpy(raw + CHUNK_AREA, chunk.background.data(), CHUNK_AREA);
+
+    std::vector<unsigned char> rle = RleEncode(raw, RAW_CHUNK_SIZE);
+
+    std::vector<unsigned char> out;
+    if (rle.size() < RAW_CHUNK_SIZE) {
+
+        out.reserve(rle.size() + 1);
+        out.push_back(ChunkEncoding::RLE);
+        out.insert(out.end(), rle.begin(), rle.end());
+
+    } else {
+
+        out.reserve(RAW_CHUNK_SIZE + 1);
+        out.push_back(ChunkEncoding::RAW);
+        out.insert(out.end(), raw, raw + RAW_CHUNK_SIZE);
+
+    }
+
+    return out;
+
+}
+
+static std::unique_ptr<Chunk> DecodeChunk(ChunkPos pos, const unsigned char *data, size_t size) {
+
+    if (size < 1) {
+        return nullptr;
+    }
+
+    unsigned char raw[RAW_CHUNK_SIZE];
+
+    if (data[0] == ChunkEncoding::RLE) {
+
+        if (!RleDecode(data + 1, size - 1, raw, RAW_CHUNK_SIZE)) {
+            return nullptr;
+        }
+
+    } else if (data[0] == ChunkEncoding::RAW && size - 1 == RAW_CHUNK_SIZE) {
+
+        std::memcpy(raw, data + 1, RAW_CHUNK_SIZE);
+
+    } else {
+
+        return nullptr;
+
+    }
+
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
+    std::memcpy(chunk->foreground.data(), raw, CHUNK_AREA);
+    std::memcpy(chunk->background.data(), raw + CHUNK_AREA, CHUNK_AREA);
+
+    return chunk;
+
+}
+
+/**
+ * WorldFile class
+ */
+
+WorldFile *WorldFile::Open(const std::string& path) {
+
+    WorldFile *worldFile = new WorldFile();
+    worldFile->path = path;
+
+    if (!std::filesystem::exists(path)) {
+
+        if (!worldFile->CreateEmpty(INITIAL_INDEX_CAPACITY)) {
+            delete worldFile;
+            return nullptr;
+        }
+
+        return worldFile;
+
+    }
+
+    {
+        MappedFile existing;
+        if (!existing.Open(path) || !worldFile->ReadIndex(existing.Data(), existing.Size())) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not read world file %s.", path.c_str());
+            delete worldFile;
+            return nullptr;
+        }
+    }
+
+    worldFile->file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!worldFile->file.is_open()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open world file %s for writing.", path.c_str());
+        delete worldFile;
+        return nullptr;
+    }
+
+    return worldFile;
+
+}
+
+WorldFile *WorldFile::OpenReadOnly(const std::string& path) {
+
+    WorldFile *worldFile = new WorldFile();
+    worldFile->path = path;
+    worldFile->readOnly = true;
+
+    if (!worldFile->mapped.Open(path) || !worldFile->ReadIndex(worldFile->mapped.Data(), worldFile->mapped.Size())) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not read world file %s.", path.c_str());
+        delete worldFile;
+        return nullptr;
+    }
+
+    return worldFile;
+
+}
+
+bool WorldFile::ReadIndex(const unsigned char *data, size_t size) {
+
+    if (size < HEADER_SIZE || std::memcmp(data, WORLD_MAGIC, sizeof(WORLD_MAGIC)) != 0) {
+        Debug::Log<Debug::LogLevel::ERROR>("%s is not a world file.", path.c_str());
+        return false;
+    }
+
+    const uint16_t version = ReadLE<uint16_t>(data + 4);
+    const uint16_t chunkSize = ReadLE<uint16_t>(data + 6);
+    indexCapacity = ReadLE<uint32_t>(data + 8);
+    const uint32_t chunkCount = ReadLE<uint32_t>(data + 12);
+
+    if (version != VERSION || chunkSize != CHUNK_SIZE) {
+        Debug::Log<Debug::LogLevel::ERROR>("World file %s has version %i and chunk size %i, expected version %i and chunk size %i.", path.c_str(), version, chunkSize, VERSION, CHUNK_SIZE);
+        return false;
+    }
+
+    if (chunkCount > indexCapacity || HEADER_SIZE + static_cast<size_t>(indexCapacity) * INDEX_ENTRY_SIZE > size) {
+        Debug::Log<Debug::LogLevel::ERROR>("World file %s has a corrupt index.", path.c_str());
+        return false;
+    }
+
+    index.resize(chunkCount);
+    slots.reserve(chunkCount);
+
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+
+        const unsigned char *p = data + HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        IndexEntry& entry = index[i];
+        entry.x = ReadLE<int32_t>(p);
+        entry.y = ReadLE<int32_t>(p + 4);
+        entry.offset = ReadLE<uint64_t>(p + 8);
+        entry.size = ReadLE<uint32_t>(p + 16);
+        entry.capacity = ReadLE<uint32_t>(p + 20);
+
+        if (entry.offset + entry.size > size) {
+            Debug::Log<Debug::LogLevel::ERROR>("World file %s has a corrupt index entry for chunk %i, %i.", path.c_str(), entry.x, entry.y);
+            return false;
+        }
+
+        slots[{entry.x, entry.y}] = i;
+
+    }
+
+    fileEnd = size;
+    return true;
+
+}
+
+bool WorldFile::CreateEmpty(uint32_t capacity) {
+
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not create world file %s.", path.c_str());
+        return false;
+    }
+
+    indexCapacity = capacity;
+    index.clear();
+    slots.clear();
+
+    if (!WriteHeader()) {
+        return false;
+    }
+
+    const std::vector<char> emptyIndex(static_cast<size_t>(capacity) * INDEX_ENTRY_SIZE, 0);
+    file.write(emptyIndex.data(), emptyIndex.size());
+    file.flush();
+
+    fileEnd = HEADER_SIZE + emptyIndex.size();
+    return file.good();
+
+}
+
+void WorldFile::EncodeHeader(unsigned char *out, uint32_t capacity, uint32_t chunkCount) {
+
+    std::memcpy(out, WORLD_MAGIC, sizeof(WORLD_MAGIC));
+    WriteLE<uint16_t>(out + 4, VERSION);
+    WriteLE<uint16_t>(out + 6, CHUNK_SIZE);
+    WriteLE<uint32_t>(out + 8, capacity);
+    WriteLE<uint32_t>(out + 12, chunkCount);
+
+}
+
+void WorldFile::EncodeIndexEntry(unsigned char *out, const IndexEntry& entry) {
+
+    WriteLE<int32_t>(out, entry.x);
+    WriteLE<int32_t>(out + 4, entry.y);
+    WriteLE<uint64_t>(out + 8, entry.offset);
+    WriteLE<uint32_t>(out + 16, entry.size);
+    WriteLE<uint32_t>(out + 20, entry.capacity);
+
+}
+
+bool WorldFile::WriteHeader() {
+
+    unsigned char header[HEADER_SIZE];
+    EncodeHeader(header, indexCapacity, static_cast<uint32_t>(index.size()));
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    return file.good();
+
+}
+
+bool WorldFile::WriteIndexEntry(size_t slot) {
+
+    unsigned char bytes[INDEX_ENTRY_SIZE];
+    EncodeIndexEntry(bytes, index[slot]);
+
+    file.seekp(HEADER_SIZE + slot * INDEX_ENTRY_SIZE);
+    file.write(reinterpret_cast<const char*>(bytes), INDEX_ENTRY_SIZE);
+    return file.good();
+
+}
+
+bool WorldFile::GrowIndex() {
+
+    //Der Index liegt vor den Chunkdaten, zum Vergrößern muss die Datei also einmal komplett neu geschrieben werden.
+    //Durch die Verdopplung passiert das nur logarithmisch oft.
+    const uint32_t newCapacity = indexCapacity * 2;
+    std::vector<IndexEntry> newIndex = index;
+
+    uint64_t newEnd = HEADER_SIZE + static_cast<uint64_t>(newCapacity) * INDEX_ENTRY_SIZE;
+    for (IndexEntry& entry : newIndex) {
+        entry.offset = newEnd;
+        entry.capacity = entry.size;
+        newEnd += entry.size;
+    }
+
+    std::vector<unsigned char> image(newEnd, 0);
+    EncodeHeader(image.data(), newCapacity, static_cast<uint32_t>(newIndex.size()));
+
+    for (size_t i = 0; i < newIndex.size(); ++i) {
+
+        EncodeIndexEntry(image.data() + HEADER_SIZE + i * INDEX_ENTRY_SIZE, newIndex[i]);
+
+        file.seekg(index[i].offset);
+        file.read(reinterpret_cast<char*>(image.data() + newIndex[i].offset), index[i].size);
+
+    }
+
+    if (!file.good()) {
+        file.clear();
+        Debug::Log<Debug::LogLevel::ERROR>("Could not read chunks while growing world file %s.", path.c_str());
+        return false;
+    }
+
+    //das Original wird erst ersetzt, wenn die neue Datei vollständig geschrieben ist; ein Absturz dazwischen lässt nur die .tmp Datei zurück
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream temp(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        temp.write(reinterpret_cast<const char*>(image.data()), image.size());
+        temp.flush();
+
+        if (!temp.good()) {
+            temp.close();
+            std::error_code ignored;
+            std::filesystem::remove(tempPath, ignored);
+            Debug::Log<Debug::LogLevel::ERROR>("Could not write %s while growing world file %s.", tempPath.c_str(), path.c_str());
+            return false;
+        }
+    }
+
+    file.close();
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+
+    if (error) {
+
+        std::error_code ignored;
+        std::filesystem::remove(tempPath, ignored);
+        Debug::Log<Debug::LogLevel::ERROR>("Could not replace world file %s: %s", path.c_str(), error.message().c_str());
+
+        //das Original ist unverändert, also mit dem alten Index weitermachen
+        file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        return false;
+
+    }
+
+    //ab hier liegt die neue Datei auf der Platte, der Index muss zu ihr passen, auch wenn das Wiederöffnen scheitert
+    indexCapacity = newCapacity;
+    index = std::move(newIndex);
+    fileEnd = newEnd;
+
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not reopen world file %s after growing it.", path.c_str());
+        return false;
+    }
+
+    return true;
+
+}
+
+std::unique_ptr<Chunk> WorldFile::LoadChunk(ChunkPos pos) {
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = slots.find(pos);
+    if (it == slots.end()) {
+        return nullptr;
+    }
+
+    const IndexEntry& entry = index[it->second];
+    std::unique_ptr<Chunk> chunk;
+
+    if (readOnly) {
+
+        chunk = DecodeChunk(pos, mapped.Data() + entry.offset, entry.size);
+
+    } else {
+
+        std::vector<unsigned char> payload(entry.size);
+        file.seekg(entry.offset);
+        file.read(reinterpret_cast<char*>(payload.data()), entry.size);
+
+        if (file.good()) {
+            chunk = DecodeChunk(pos, payload.data(), payload.size());
+        } else {
+            file.clear();
+        }
+
+    }
+
+    if (chunk == nullptr) {
+        Debug::Log<Debug::LogLevel::ERROR>("Chunk %i, %i in world file %s is corrupt.", pos.x, pos.y, path.c_str());
+    }
+
+    return chunk;
+
+}
+
+void WorldFile::SaveChunk(const Chunk& chunk) {
+
+    if (readOnly) {
+        return;
+    }
+
+    const std::vector<unsigned char> payload = EncodeChunk(chunk);
+    const uint32_t payloadSize = static_cast<uint32_t>(payload.size());
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t slot;
+    const auto it = slots.find(chunk.pos);
+
+    if (it != slots.end()) {
+
+        slot = it->second;
+
+    } else {
+
+        if (index.size() == indexCapacity && !GrowIndex()) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not save chunk %i, %i to world file %s.", chunk.pos.x, chunk.pos.y, path.c_str());
+            return;
+        }
+
+        slot = index.size();
+        index.push_back({chunk.pos.x, chunk.pos.y, 0, 0, 0});
+        slots[chunk.pos] = slot;
+        WriteHeader();
+
+    }
+
+    IndexEntry& entry = index[slot];
+
+    if (payloadSize > entry.capacity) {
+
+        entry.offset = fileEnd;
+        entry.capacity = payloadSize;
+        fileEnd += payloadSize;
+
+    }
+
+    entry.size = payloadSize;
+
+    file.seekp(entry.offset);
+    file.write(reinterpret_cast<const char*>(payload.data()), payloadSize);
+    WriteIndexEntry(slot);
+    file.flush();
+
+    if (!file.good()) {
+        file.clear();
+        Debug::Log<Debug::LogLevel::ERROR>("Could not write chunk %i, %i to world file %s.", chunk.pos.x, chunk.pos.y, path.c_str());
+    }
+
+}
+
+bool WorldFile::IsReadOnly() const {
+
+    return readOnly;
+
+}
+
+size_t WorldFile::GetChunkCount() const {
+
+    return index.size();
+
+}
+
+/**
+ * Free functions
+ */
+
+std::vector<unsigned char> RleEncode(const unsigned char *data, size_t size) {
+
+    std::vector<unsigned char> out;
+    size_t i = 0;
+
+    while (i < size) {
+
+        const unsigned char value = data[i];
+        size_t run = 1;
+        while (i + run < size && run < 255 && data[i + run] == value) {
+            ++run;
+        }
+
+        out.push_back(static_cast<unsigned char>(run));
+        out.push_back(value);
+        i += run;
+
+    }
+
+    return out;
+
+}
+
+bool RleDecode(const unsigned char *in, size_t inSize, unsigned char *out, size_t outSize) {
+
+    if (inSize % 2 != 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < inSize; i += 2) {
+
+        const size_t run = in[i];
+        if (run == 0 || written + run > outSize) {
+            return false;
+        }
+
+        std::memset(out + written, in[i + 1], run);
+        written += run;
+
+    }
+
+    return written == outSize;
+
+}
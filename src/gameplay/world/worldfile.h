@@ -0,0 +1,79 @@
+#pragma once
+
+#include "streaming.h"
+
+#include "../../io/mapped_file.h"
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Binäres Speicherformat der Tile-Welt (.sww), alle Zahlen little endian:
+ *
+ *  Header      magic "SWWD", u16 version, u16 chunkSize, u32 indexCapacity, u32 chunkCount
+ *  Index       indexCapacity Einträge: i32 x, i32 y, u64 offset, u32 size, u32 capacity
+ *  Chunkdaten  pro Chunk: u8 encoding (0 = roh, 1 = RLE), danach Vorder- und Hintergrundebene hintereinander
+ *
+ * Jeder Chunk kann über den Index einzeln gelesen oder neu geschrieben werden, ohne den Rest der Datei anzufassen.
+ * Passt ein neu geschriebener Chunk nicht mehr in seinen alten Platz, wird er ans Dateiende gehängt.
+ */
+class WorldFile final : public ChunkSource {
+    public:
+        static constexpr uint16_t VERSION = 1;
+        /**
+         * Öffnet eine Weltdatei zum Lesen und Schreiben, oder legt sie an falls sie nicht existiert. Gibt nullptr zurück, wenn das fehlschlägt.
+         */
+        static WorldFile *Open(const std::string& path);
+        /**
+         * Öffnet eine Weltdatei nur-lesend über ein Memory-Mapping. Chunks werden direkt aus dem Mapping dekodiert, SaveChunk() ist wirkungslos.
+         */
+        static WorldFile *OpenReadOnly(const std::string& path);
+        ~WorldFile() override = default;
+        virtual std::unique_ptr<Chunk> LoadChunk(ChunkPos pos) override;
+        virtual void SaveChunk(const Chunk& chunk) override;
+        bool IsReadOnly() const;
+        size_t GetChunkCount() const;
+    private:
+        struct IndexEntry {
+            int32_t x;
+            int32_t y;
+            uint64_t offset;
+            uint32_t size;
+            uint32_t capacity;
+        };
+        WorldFile() = default;
+        bool ReadIndex(const unsigned char *data, size_t size);
+        bool CreateEmpty(uint32_t indexCapacity);
+        static void EncodeHeader(unsigned char *out, uint32_t indexCapacity, uint32_t chunkCount);
+        static void EncodeIndexEntry(unsigned char *out, const IndexEntry& entry);
+        bool WriteHeader();
+        bool WriteIndexEntry(size_t slot);
+        /**
+         * Schreibt die Datei mit doppelter Indexkapazität nach path + ".tmp" und ersetzt erst dann das Original. Schlägt das fehl,
+         * bleiben Datei und Index unverändert.
+         */
+        bool GrowIndex();
+        std::string path;
+        bool readOnly = false;
+        MappedFile mapped;
+        std::fstream file;
+        uint32_t indexCapacity = 0;
+        std::vector<IndexEntry> index;
+        std::unordered_map<ChunkPos, size_t, ChunkPosHash> slots;
+        uint64_t fileEnd = 0;
+        std::mutex mutex;
+};
+
+/**
+ * Run-length Kodierung als (Anzahl, Wert) Paare, Anzahl 1..255. Da Tiles meistens großflächig gleich sind, reicht das für große Einsparungen.
+ */
+std::vector<unsigned char> RleEncode(const unsigned char *data, size_t size);
+
+/**
+ * Dekodiert genau outSize Bytes. Gibt false zurück, wenn die Eingabe nicht exakt outSize Bytes ergibt.
+ */
+bool RleDecode(const unsigned char *in, size_t inSize, unsigned char *out, size_t outSize);
@@ -1,8 +1,196 @@
 #include "debug.h"
 
-void Debug::PrintLogLevel(Debug::LogLevel level) {
+#include "../engine/ringbuffer.h"
 
-    static const char *names[] = {"[INFO]", "[DEBUG]", "[WARNING]", "[ERROR]", "[FATAL]"};
-    printf(names[level]);
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
-}
\ No newline at end of file
+namespace Debug {
+
+    struct LogRecord {
+        LogLevel level;
+        unsigned short length;
+        char text[LOG_MESSAGE_SIZE];
+    };
+
+    static constexpr size_t LOG_QUEUE_CAPACITY = 4096;
+
+    struct LoggerState {
+        MpscRingBuffer<LogRecord, LOG_QUEUE_CAPACITY> queue;
+        //der Logging-Thread schläft auf published, Flush() wartet bis written submitted eingeholt hat
+        std::atomic<unsigned int> published{0};
+        std::atomic<unsigned int> submitted{0};
+        std::atomic<unsigned int> written{0};
+        std::atomic<size_t> dropped{0};
+        std::atomic<bool> running{false};
+        std::atomic<bool> stopping{false};
+        std::thread thread;
+        FILE *file = nullptr;
+        std::mutex outputMutex;
+    };
+
+    static std::atomic<int> logLevel{LogLevel::INFO};
+
+    //wird absichtlich nie freigegeben, damit auch Logs aus statischen Destruktoren noch funktionieren
+    static LoggerState *logger = nullptr;
+    static std::once_flag loggerInit;
+
+    const char *GetLogLevelName(LogLevel level) {
+
+        static const char *names[] = {"[DEBUG]", "[INFO]", "[WARNING]", "[ERROR]", "[FATAL]"};
+        return names[level];
+
+    }
+
+    void SetLogLevel(LogLevel level) {
+
+        logLevel.store(level, std::memory_order_relaxed);
+
+    }
+
+    LogLevel GetLogLevel() {
+
+        return static_cast<LogLevel>(logLevel.load(std::memory_order_relaxed));
+
+    }
+
+    static void WriteOutput(const char *text, size_t length) {
+
+        std::lock_guard<std::mutex> lock(logger->outputMutex);
+
+        if constexpr (Config::LOG_TO_CONSOLE) {
+            fwrite(text, 1, length, stdout);
+            fputc('\n', stdout);
+        }
+
+        if (logger->file != nullptr) {
+            fwrite(text, 1, length, logger->file);
+            fputc('\n', logger->file);
+        }
+
+    }
+
+    static void Drain() {
+
+        LogRecord record;
+        while (logger->queue.TryPop(record)) {
+
+            WriteOutput(record.text, record.length);
+            logger->written.fetch_add(1, std::memory_order_release);
+
+        }
+
+        const size_t dropped = logger->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+
+            char text[64];
+            const int length = snprintf(text, sizeof(text), "%s %zu log messages were dropped.", GetLogLevelName(LogLevel::WARNING), dropped);
+            WriteOutput(text, static_cast<size_t>(length));
+
+        }
+
+        if constexpr (Config::LOG_TO_CONSOLE) {
+            fflush(stdout);
+        }
+        if (logger->file != nullptr) {
+            fflush(logger->file);
+        }
+
+    }
+
+    static void LoggingThread() {
+
+        unsigned int seen = 0;
+
+        while (!logger->stopping.load(std::memory_order_acquire)) {
+
+            logger->published.wait(seen, std::memory_order_acquire);
+            seen = logger->published.load(std::memory_order_acquire);
+            Drain();
+
+        }
+
+        Drain();
+
+    }
+
+    static void StopLogger() {
+
+        logger->stopping.store(true, std::memory_order_release);
+        logger->published.fetch_add(1, std::memory_order_release);
+        logger->published.notify_one();
+        logger->thread.join();
+        logger->running.store(false, std::memory_order_release);
+
+        if (logger->file != nullptr) {
+            fclose(logger->file);
+            logger->file = nullptr;
+        }
+
+    }
+
+    static void InitLogger() {
+
+        logger = new LoggerState();
+
+        if (Config::LOG_FILE[0] != '\0') {
+            logger->file = fopen(Config::LOG_FILE, "w");
+        }
+
+        logger->thread = std::thread(LoggingThread);
+        logger->running.store(true, std::memory_order_release);
+
+        std::atexit(StopLogger);
+
+    }
+
+    void Submit(LogLevel level, const char *text, size_t length) {
+
+        std::call_once(loggerInit, InitLogger);
+
+        //nach dem Beenden des Logging-Threads (Programmende) direkt schreiben
+        if (!logger->running.load(std::memory_order_acquire)) {
+            WriteOutput(text, length);
+            return;
+        }
+
+        LogRecord record;
+        record.level = level;
+        record.length = static_cast<unsigned short>(length);
+        std::memcpy(record.text, text, length);
+
+        if (!logger->queue.TryPush(record)) {
+            logger->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        logger->submitted.fetch_add(1, std::memory_order_release);
+        logger->published.fetch_add(1, std::memory_order_release);
+        logger->published.notify_one();
+
+        if (level == LogLevel::FATAL) {
+            Flush();
+        }
+
+    }
+
+    void Flush() {
+
+        if (logger == nullptr || !logger->running.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        const unsigned int target = logger->submitted.load(std::memory_order_acquire);
+
+        while (logger->written.load(std::memory_order_acquire) < target && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+
+    }
+
+}
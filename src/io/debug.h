@@ -1,9 +1,18 @@
 #pragma once
 
+#include <cstddef>
 #include <stdio.h>
 
 namespace Debug {
 
+    enum LogLevel {
+        DEBUG = 0,
+        INFO,
+        WARNING, 
+        ERROR, 
+        FATAL
+    };
+
     /**
      * Enthält alle Debugvariablen, allesamt zur Compilezeit bekannt.
      */
@@ -14,55 +23,122 @@ namespace Debug {
          */
         inline constexpr bool DO_LOGGING = true;
 
+        /**
+         * Log<level>(...) Aufrufe unterhalb dieses Levels werden zur Compilezeit entfernt.
+         */
+        inline constexpr LogLevel MIN_LOG_LEVEL = LogLevel::DEBUG;
+
+        /**
+         * Ob der Logging-Thread in die Konsole schreibt.
+         */
+        inline constexpr bool LOG_TO_CONSOLE = true;
+
+        /**
+         * Wenn nicht leer, schreibt der Logging-Thread zusätzlich in diese Datei.
+         */
+        inline constexpr const char *LOG_FILE = "";
+
         /**
          * Wenn true, gibt eine Warnung aus wenn ein asset geladen werden soll das nicht existiert.
          */
         inline constexpr bool LOG_MISSING_ASSETS = true;
 
+        /**
+         * Wenn true, beobachten AssetManager ihre Suchordner (nur Linux/inotify) und verwerfen ihren Pfadcache, sobald sich dort Dateien ändern.
+         * Ohne das wird ein Suchordner nur einmal beim Hinzufügen indiziert; später angelegte Dateien werden dann nicht gefunden.
+         */
+        inline constexpr bool WATCH_ASSET_DIRS = false;
+
+        /**
+         * Wenn true, werden geänderte Texturen, Sounds und .ani Dateien im laufenden Spiel neu geladen und unter demselben Identifier ersetzt.
+         * Beobachtet die Suchordner wie WATCH_ASSET_DIRS. Nur für die Entwicklung gedacht.
+         */
+        inline constexpr bool HOT_RELOAD = false;
+
+        /**
+         * Wenn false, werden alle PROFILE_ZONE Marker und der Profiler selbst komplett wegoptimiert.
+         */
+        inline constexpr bool DO_PROFILING = true;
+
     }
 
-    enum LogLevel {
-        INFO = 0,
-        DEBUG,
-        WARNING, 
-        ERROR, 
-        FATAL
-    };
+    /**
+     * Maximale Länge einer Lognachricht inklusive Level-Präfix, längere Nachrichten werden abgeschnitten.
+     */
+    inline constexpr size_t LOG_MESSAGE_SIZE = 256;
+
+    /**
+     * Jeder Thread formatiert seine Nachrichten in einen eigenen Puffer, damit Log(...) nichts allokieren und nichts sperren muss.
+     */
+    inline thread_local char formatBuffer[LOG_MESSAGE_SIZE];
+
+    const char *GetLogLevelName(LogLevel level);
+
+    /**
+     * Laufzeit-Schwellwert: Nachrichten unterhalb dieses Levels werden verworfen. Standard ist INFO.
+     */
+    void SetLogLevel(LogLevel level);
+
+    LogLevel GetLogLevel();
 
     /**
-     * Druckt den namen eines LogLevels in die Konsole. Wird eigentlich nur von den Log(...) Funktionen gebraucht und sollte so nicht verwendet werden.
+     * Übergibt eine fertig formatierte Nachricht an den Logging-Thread. Wird eigentlich nur von den Log(...) Funktionen gebraucht und sollte so nicht verwendet werden.
      */
-    void PrintLogLevel(LogLevel level);
+    void Submit(LogLevel level, const char *text, size_t length);
 
     /**
-     * Loggt eine Nachricht, wenn Debug::Config::DO_LOGGING true ist
+     * Wartet, bis der Logging-Thread alle bisher abgeschickten Nachrichten geschrieben hat.
      */
+    void Flush();
+
     template<typename... Formatters>
-    void Log(LogLevel level, const char *message, Formatters... f) {
+    void Format(LogLevel level, const char *message, Formatters... f) {
+
+        int length;
+        if constexpr (sizeof...(Formatters) == 0) {
+            length = snprintf(formatBuffer, LOG_MESSAGE_SIZE, "%s %s", GetLogLevelName(level), message);
+        } else {
+            const int prefixLength = snprintf(formatBuffer, LOG_MESSAGE_SIZE, "%s ", GetLogLevelName(level));
+            length = prefixLength + snprintf(formatBuffer + prefixLength, LOG_MESSAGE_SIZE - prefixLength, message, f...);
+        }
 
-        if (!Config::DO_LOGGING)
+        if (length < 0) {
             return;
+        }
 
-        PrintLogLevel(level);
-        printf(" ");
-        printf(message, f...);
-        printf("\n");
+        const size_t clamped = static_cast<size_t>(length) < LOG_MESSAGE_SIZE ? static_cast<size_t>(length) : LOG_MESSAGE_SIZE - 1;
+        Submit(level, formatBuffer, clamped);
 
     }
 
     /**
-     * Loggt eine Nachricht, wenn Debug::Config::DO_LOGGING true ist
+     * Loggt eine Nachricht, wenn Debug::Config::DO_LOGGING true ist, z.B. Log<LogLevel::WARNING>("...").
+     * Der Level ist ein Template-Parameter, damit Aufrufe unterhalb von Config::MIN_LOG_LEVEL samt ihrer Argumente zur Compilezeit wegfallen.
+     * Formatiert wird auf dem aufrufenden Thread, geschrieben asynchron auf dem Logging-Thread.
      */
-    template<typename... Formatters>
+    template<LogLevel level, typename... Formatters>
     void Log(const char *message, Formatters... f) {
 
-        if (!Config::DO_LOGGING)
+        if constexpr (!Config::DO_LOGGING || level < Config::MIN_LOG_LEVEL) {
             return;
+        } else {
+
+            if (level < GetLogLevel())
+                return;
+
+            Format(level, message, f...);
+
+        }
+
+    }
+
+    /**
+     * Loggt eine Nachricht mit Level INFO, wenn Debug::Config::DO_LOGGING true ist
+     */
+    template<typename... Formatters>
+    void Log(const char *message, Formatters... f) {
 
-        PrintLogLevel(LogLevel::INFO);
-        printf(" ");
-        printf(message, f...);
-        printf("\n");
+        Log<LogLevel::INFO>(message, f...);
 
     }
 
@@ -72,11 +148,8 @@ namespace Debug {
     template<typename... Formatters>
     void Debug(const char *message, Formatters... f) {
 
-        PrintLogLevel(LogLevel::DEBUG);
-        printf(" ");
-        printf(message, f...);
-        printf("\n");
+        Format(LogLevel::DEBUG, message, f...);
 
     }
 
-}
\ No newline at end of file
+}
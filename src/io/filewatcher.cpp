@@ -0,0 +1,152 @@
+#include "filewatcher.h"
+
+#include "debug.h"
+
+#include <utility>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+bool FileWatcher::IsSupported() {
+    return true;
+}
+
+FileWatcher::~FileWatcher() {
+
+    if (thread.joinable()) {
+        const char wake = 0;
+        (void) !write(wakeFds[1], &wake, 1);
+        thread.join();
+    }
+
+    for (const int fd : {inotifyFd, wakeFds[0], wakeFds[1]}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+}
+
+bool FileWatcher::Watch(const std::string& dir) {
+
+    if (inotifyFd < 0) {
+
+        inotifyFd = inotify_init1(IN_CLOEXEC);
+        if (inotifyFd < 0) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not initialize inotify.");
+            return false;
+        }
+
+        if (pipe(wakeFds) != 0) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not create file watcher wake pipe.");
+            close(inotifyFd);
+            inotifyFd = -1;
+            return false;
+        }
+
+    }
+
+    const int wd = inotify_add_watch(inotifyFd, dir.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ONLYDIR);
+    if (wd < 0) {
+        Debug::Log<Debug::LogLevel::WARNING>("Could not watch directory %s.", dir.c_str());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        watches[wd] = dir;
+    }
+
+    if (!thread.joinable()) {
+        thread = std::thread(&FileWatcher::Run, this);
+    }
+
+    return true;
+
+}
+
+void FileWatcher::Run() {
+
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+
+        if (fds[1].revents != 0) {
+            return;
+        }
+
+        const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (ssize_t offset = 0; offset < length;) {
+
+            const inotify_event *event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            const auto it = watches.find(event->wd);
+            if (it == watches.end() || event->len == 0) {
+                continue;
+            }
+
+            std::string path = it->second;
+            if (!path.empty() && path.back() != '/') {
+                path += '/';
+            }
+            path += event->name;
+
+            events.push_back({it->second, event->name, std::move(path)});
+
+        }
+
+        pending.store(!events.empty(), std::memory_order_release);
+
+    }
+
+}
+
+#else
+
+bool FileWatcher::IsSupported() {
+    return false;
+}
+
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::Watch(const std::string& dir) {
+
+    (void) dir;
+    return false;
+
+}
+
+void FileWatcher::Run() {}
+
+#endif
+
+bool FileWatcher::HasEvents() const {
+
+    return pending.load(std::memory_order_acquire);
+
+}
+
+std::vector<FileEvent> FileWatcher::TakeEvents() {
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.store(false, std::memory_order_release);
+    return std::exchange(events, {});
+
+}
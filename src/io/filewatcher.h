@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Eine Änderung in einem beobachteten Ordner. path ist der Ordnerpfad wie an Watch() übergeben plus Dateiname.
+ */
+struct FileEvent {
+    std::string dir;
+    std::string name;
+    std::string path;
+};
+
+/**
+ * Beobachtet Ordner (nicht rekursiv) auf angelegte, gelöschte, verschobene und fertig geschriebene Dateien.
+ * Ein Hintergrundthread blockiert auf inotify und sammelt die Events; HasEvents() ist nur ein atomarer Load und kann jeden Frame abgefragt werden.
+ * Wird nur unter Linux unterstützt, auf anderen Plattformen schlägt Watch() fehl und es kommen nie Events.
+ */
+class FileWatcher final {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+        static bool IsSupported();
+        /**
+         * Fügt einen Ordner hinzu. Der Hintergrundthread startet beim ersten erfolgreichen Aufruf. Mehrfaches Hinzufügen desselben Ordners ist erlaubt.
+         */
+        bool Watch(const std::string& dir);
+        bool HasEvents() const;
+        /**
+         * Gibt alle seit dem letzten Aufruf gesammelten Events zurück.
+         */
+        std::vector<FileEvent> TakeEvents();
+    private:
+        void Run();
+        int inotifyFd = -1;
+        //Pipe, über die der Destruktor den blockierten Thread aufweckt
+        int wakeFds[2] = {-1, -1};
+        std::thread thread;
+        std::mutex mutex;
+        std::unordered_map<int, std::string> watches;
+        std::vector<FileEvent> events;
+        std::atomic<bool> pending = false;
+};
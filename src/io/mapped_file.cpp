@@ -0,0 +1,190 @@
+#include "mapped_file.h"
+
+#include "debug.h"
+
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    //wingdi.h definiert ERROR als Makro, das würde Debug::LogLevel::ERROR zerschießen
+    #define NOGDI
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+
+    Close();
+
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+
+    *this = std::move(other);
+
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+
+    if (this != &other) {
+
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+        open = std::exchange(other.open, false);
+
+    }
+
+    return *this;
+
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open file %s for mapping.", path.c_str());
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        Debug::Log<Debug::LogLevel::ERROR>("Could not query size of %s.", path.c_str());
+        return false;
+    }
+
+    fileHandle = file;
+    size = static_cast<size_t>(fileSize.QuadPart);
+    open = true;
+
+    //leere Dateien können nicht gemappt werden, sind aber trotzdem gültig
+    if (size == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        Close();
+        Debug::Log<Debug::LogLevel::ERROR>("Could not map file %s.", path.c_str());
+        return false;
+    }
+
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (data == nullptr) {
+        Close();
+        Debug::Log<Debug::LogLevel::ERROR>("Could not map view of file %s.", path.c_str());
+        return false;
+    }
+
+    return true;
+
+}
+
+void MappedFile::Close() {
+
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    open = false;
+
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open file %s for mapping.", path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        Debug::Log<Debug::LogLevel::ERROR>("Could not query size of %s.", path.c_str());
+        return false;
+    }
+
+    size = static_cast<size_t>(st.st_size);
+    open = true;
+
+    if (size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //das Mapping bleibt auch nach dem Schließen des Deskriptors bestehen
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        open = false;
+        Debug::Log<Debug::LogLevel::ERROR>("Could not map file %s.", path.c_str());
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    return true;
+
+}
+
+void MappedFile::Close() {
+
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    data = nullptr;
+    size = 0;
+    open = false;
+
+}
+
+#endif
+
+bool MappedFile::IsOpen() const {
+
+    return open;
+
+}
+
+const unsigned char *MappedFile::Data() const {
+
+    return data;
+
+}
+
+size_t MappedFile::Size() const {
+
+    return size;
+
+}
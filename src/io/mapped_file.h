@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Eine nur-lesend in den Speicher gemappte Datei. Solange das Objekt lebt, bleibt Data() gültig.
+ */
+class MappedFile final {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        /**
+         * Mappt die Datei. Gibt false zurück (und loggt), wenn die Datei nicht geöffnet oder gemappt werden konnte.
+         */
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const;
+        const unsigned char *Data() const;
+        size_t Size() const;
+    private:
+        const unsigned char *data = nullptr;
+        size_t size = 0;
+        //Plattformspezifische Handles; unter Windows Datei- und Mapping-Handle, sonst ungenutzt.
+        void *fileHandle = nullptr;
+        void *mappingHandle = nullptr;
+        bool open = false;
+};
@@ -0,0 +1,278 @@
+#include "profiler.h"
+
+#include "../engine/assets.h"
+#include "../engine/ringbuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Profiler {
+
+    static constexpr size_t EVENT_CAPACITY = 1 << 14;
+    static constexpr size_t STATS_HISTORY = 120;
+    static constexpr size_t TRACE_FRAMES = 600;
+
+    struct ZoneStats {
+        std::array<double, STATS_HISTORY> samples{};
+        size_t sampleCount = 0;
+        size_t nextSample = 0;
+        double currentFrame = 0;
+        bool seenThisFrame = false;
+        unsigned short depth = 0;
+        size_t order = 0;
+    };
+
+    struct ProfilerState {
+        MpscRingBuffer<ZoneEvent, EVENT_CAPACITY> events;
+        std::atomic<size_t> droppedEvents{0};
+        std::atomic<unsigned short> nextThreadId{0};
+        std::unordered_map<std::string_view, ZoneStats> stats;
+        std::deque<std::vector<ZoneEvent>> frames;
+        long long frameStart = 0;
+        bool overlayVisible = false;
+    };
+
+    //wird erst beim ersten Zugriff angelegt, damit ohne Profiling auch kein Speicher belegt wird
+    static ProfilerState& State() {
+
+        static ProfilerState state;
+        return state;
+
+    }
+
+    static thread_local unsigned short zoneDepth = 0;
+
+    static unsigned short ThreadId() {
+
+        static thread_local const unsigned short id = State().nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+
+    }
+
+    long long Now() {
+
+        static const SteadyClock clock;
+        return clock.NowNanos();
+
+    }
+
+    unsigned short EnterZone() {
+
+        return zoneDepth++;
+
+    }
+
+    void LeaveZone(const char *name, long long start, unsigned short depth) {
+
+        zoneDepth = depth;
+
+        const ZoneEvent event{name, start, Now(), depth, ThreadId()};
+
+        if (!State().events.TryPush(event)) {
+            State().droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    }
+
+    static void AddSample(ZoneStats& zone, double millis) {
+
+        zone.samples[zone.nextSample] = millis;
+        zone.nextSample = (zone.nextSample + 1) % STATS_HISTORY;
+        zone.sampleCount = std::min(zone.sampleCount + 1, STATS_HISTORY);
+
+    }
+
+    void EndFrame() {
+
+        if constexpr (!Debug::Config::DO_PROFILING) {
+            return;
+        }
+
+        ProfilerState& state = State();
+        const long long now = Now();
+
+        std::vector<ZoneEvent> frame;
+        frame.push_back({"FRAME", state.frameStart == 0 ? now : state.frameStart, now, 0, ThreadId()});
+
+        ZoneEvent event;
+        while (state.events.TryPop(event)) {
+            frame.push_back(event);
+        }
+
+        state.frameStart = now;
+
+        for (const ZoneEvent& e : frame) {
+
+            auto [it, inserted] = state.stats.try_emplace(e.name);
+            ZoneStats& zone = it->second;
+
+            if (inserted) {
+                zone.order = state.stats.size();
+            }
+
+            //Zonen auf Worker-Threads hängen nicht im Baum des Main-Threads, werden aber trotzdem unter FRAME eingerückt
+            zone.depth = static_cast<unsigned short>(e.depth + (e.name == frame[0].name ? 0 : 1));
+            zone.currentFrame += static_cast<double>(e.end - e.start) / 1'000'000.0;
+            zone.seenThisFrame = true;
+
+        }
+
+        for (auto& [name, zone] : state.stats) {
+
+            if (zone.seenThisFrame) {
+                AddSample(zone, zone.currentFrame);
+            }
+
+            zone.currentFrame = 0;
+            zone.seenThisFrame = false;
+
+        }
+
+        state.frames.push_back(std::move(frame));
+        if (state.frames.size() > TRACE_FRAMES) {
+            state.frames.pop_front();
+        }
+
+    }
+
+    void ToggleOverlay() {
+
+        if constexpr (Debug::Config::DO_PROFILING) {
+            State().overlayVisible = !State().overlayVisible;
+        }
+
+    }
+
+    bool IsOverlayVisible() {
+
+        if constexpr (!Debug::Config::DO_PROFILING) {
+            return false;
+        }
+
+        return State().overlayVisible;
+
+    }
+
+    void DrawOverlay(FontRenderer *font, Vector2 position, float scaleFactor) {
+
+        if constexpr (!Debug::Config::DO_PROFILING) {
+            return;
+        }
+
+        ProfilerState& state = State();
+
+        std::vector<std::pair<std::string_view, const ZoneStats*>> zones;
+        for (const auto& [name, zone] : state.stats) {
+            if (zone.sampleCount > 0) {
+                zones.emplace_back(name, &zone);
+            }
+        }
+
+        std::sort(zones.begin(), zones.end(), [](const auto& a, const auto& b) {
+            return a.second->order < b.second->order;
+        });
+
+        constexpr float INDENT = 24;
+        constexpr float LINE_SPACING = 4;
+        float y = position.y;
+
+        //alle Zeilen zusammen: das ganze Overlay ist dann ein Draw Call
+        SpriteBatch batch;
+        font->SetSpriteBatch(&batch);
+
+        for (const auto& [name, zone] : zones) {
+
+            std::array<double, STATS_HISTORY> sorted;
+            std::copy_n(zone->samples.begin(), zone->sampleCount, sorted.begin());
+            std::sort(sorted.begin(), sorted.begin() + zone->sampleCount);
+
+            double sum = 0;
+            for (size_t i = 0; i < zone->sampleCount; ++i) {
+                sum += sorted[i];
+            }
+
+            const double min = sorted[0];
+            const double avg = sum / zone->sampleCount;
+            const double p99 = sorted[std::min(zone->sampleCount - 1, (zone->sampleCount * 99) / 100)];
+
+            char line[160];
+            std::snprintf(line, sizeof(line), "%.*s: MIN %.2f AVG %.2f P99 %.2f", static_cast<int>(name.size()), name.data(), min, avg, p99);
+
+            const Vector2 linePosition{position.x + zone->depth * INDENT * scaleFactor, y};
+            const Vector2 size = font->DrawStringAndMeasure(line, linePosition, scaleFactor);
+            y += size.y + LINE_SPACING * scaleFactor;
+
+        }
+
+        const size_t dropped = state.droppedEvents.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+
+            char line[64];
+            std::snprintf(line, sizeof(line), "DROPPED: %zu", dropped);
+            font->DrawString(line, {position.x, y}, scaleFactor);
+
+        }
+
+        font->SetSpriteBatch(nullptr);
+        batch.Flush();
+
+    }
+
+    static void WriteJsonString(FILE *file, const char *str) {
+
+        std::fputc('"', file);
+        for (const char *c = str; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+            }
+            std::fputc(*c, file);
+        }
+        std::fputc('"', file);
+
+    }
+
+    bool DumpChromeTrace(const std::string& path) {
+
+        if constexpr (!Debug::Config::DO_PROFILING) {
+            return false;
+        }
+
+        FILE *file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            Debug::Log<Debug::LogLevel::ERROR>("Could not open %s for writing the profiler trace.", path.c_str());
+            return false;
+        }
+
+        std::fputs("{\"traceEvents\":[\n", file);
+
+        bool first = true;
+        for (const std::vector<ZoneEvent>& frame : State().frames) {
+            for (const ZoneEvent& e : frame) {
+
+                if (!first) {
+                    std::fputs(",\n", file);
+                }
+                first = false;
+
+                std::fputs("{\"name\":", file);
+                WriteJsonString(file, e.name);
+                std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}", e.start / 1000.0, (e.end - e.start) / 1000.0, static_cast<unsigned int>(e.thread));
+
+            }
+        }
+
+        std::fputs("\n]}\n", file);
+        std::fclose(file);
+
+        Debug::Log("Wrote profiler trace to %s.", path.c_str());
+        return true;
+
+    }
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "debug.h"
+
+#include "../engine/timer.h"
+
+#include <string>
+
+class FontRenderer;
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Misst die Zeit bis zum Ende des umschließenden Scopes. name muss ein String-Literal (oder anderweitig dauerhaft gültig) sein.
+ * Ist Debug::Config::DO_PROFILING false, bleibt davon nach dem Kompilieren nichts übrig.
+ */
+#define PROFILE_ZONE(name) ::Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+
+/**
+ * Leichtgewichtiger CPU-Profiler. Zonen werden von beliebigen Threads lock-frei in einen Ringpuffer geschrieben und einmal pro Frame
+ * auf dem Main-Thread (EndFrame()) zu Statistiken pro Zone (min/avg/p99 über die letzten Frames) zusammengefasst.
+ */
+namespace Profiler {
+
+    struct ZoneEvent {
+        const char *name;
+        long long start;
+        long long end;
+        unsigned short depth;
+        unsigned short thread;
+    };
+
+    /**
+     * Werden nur von ScopedZone gebraucht und sollten so nicht verwendet werden.
+     */
+    unsigned short EnterZone();
+    void LeaveZone(const char *name, long long start, unsigned short depth);
+    long long Now();
+
+    template<bool ENABLED>
+    class ScopedZone;
+
+    template<>
+    class ScopedZone<true> final {
+        public:
+            explicit ScopedZone(const char *name) : name(name), depth(EnterZone()), start(Now()) {}
+            ~ScopedZone() {
+                LeaveZone(name, start, depth);
+            }
+            ScopedZone(const ScopedZone&) = delete;
+            ScopedZone& operator=(const ScopedZone&) = delete;
+        private:
+            const char *name;
+            unsigned short depth;
+            long long start;
+    };
+
+    template<>
+    class ScopedZone<false> final {
+        public:
+            constexpr explicit ScopedZone(const char*) {}
+    };
+
+    using Zone = ScopedZone<Debug::Config::DO_PROFILING>;
+
+    /**
+     * Schließt den aktuellen Frame ab: sammelt alle bis jetzt beendeten Zonen ein und aktualisiert die Statistiken. Einmal pro Frame auf dem Main-Thread aufrufen.
+     */
+    void EndFrame();
+
+    void ToggleOverlay();
+
+    bool IsOverlayVisible();
+
+    /**
+     * Zeichnet pro Zone eine Zeile mit min/avg/p99 in Millisekunden, eingerückt nach Verschachtelungstiefe.
+     */
+    void DrawOverlay(FontRenderer *font, Vector2 position, float scaleFactor = 1.0f);
+
+    /**
+     * Schreibt die zuletzt aufgezeichneten Frames im Chrome Trace Format (chrome://tracing, Perfetto) in eine Datei.
+     */
+    bool DumpChromeTrace(const std::string& path);
+
+}
@@ -4,9 +4,11 @@
 #include "engine/assets.h"
 #include "engine/timer.h"
 #include "io/debug.h"
+#include "io/profiler.h"
 #include "gameplay/sunworld.h"
 
-static constexpr int TICKS_PER_SECOND = 20;
+static constexpr int MAX_CATCH_UP_TICKS = 5;
+static constexpr size_t MAX_ASSET_UPLOADS_PER_FRAME = 4;
 
 int main() {
 
@@ -23,24 +25,48 @@ int main() {
 
     Sunworld::Init();
 
-    TickTimer timer(TICKS_PER_SECOND);
+    FixedTimestep timestep(Sunworld::TICKS_PER_SECOND, MAX_CATCH_UP_TICKS);
 
     while (!WindowShouldClose()) {
 
-        if (timer.ShouldTick()) {
+        const int ticks = timestep.BeginFrame();
 
+        for (int i = 0; i < ticks; ++i) {
+
+            Sunworld::InstallStreamedChunks();
             Sunworld::Update();
 
         }
 
+        AssetManager::ProcessUploads(MAX_ASSET_UPLOADS_PER_FRAME);
+
         BeginDrawing(); {
 
-            Sunworld::Render(timer.GetPartialTick());
+            Sunworld::Render(timestep.GetAlpha());
             
         } EndDrawing();
 
+        //Framegrenze: ab hier wird nichts aus diesem Frame mehr gezeichnet
+        AssetManager::TrimCaches();
+
+        Profiler::EndFrame();
+
+        if constexpr (Debug::Config::DO_PROFILING) {
+
+            if (IsKeyPressed(KEY_F3)) {
+                Profiler::ToggleOverlay();
+            }
+
+            if (IsKeyPressed(KEY_F4)) {
+                Profiler::DumpChromeTrace("profile.json");
+            }
+
+        }
+
     }
 
+    Sunworld::Shutdown();
+
     CloseAudioDevice();
     CloseWindow();
 
@@ -0,0 +1,158 @@
+#include "test.h"
+
+#include "../src/engine/assetcache.h"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Ein "Asset" ist nur seine Größe in Bytes plus eine Nummer, an der man Entladen und Hot Reload erkennt.
+ */
+struct FakeResource {
+    size_t bytes = 0;
+    int version = 0;
+};
+
+/**
+ * Zählt mit, welche Einträge entladen wurden. Der Cache kopiert das Backend, deshalb zeigt es auf ein Protokoll des Tests.
+ */
+struct FakeCacheBackend {
+    std::vector<int> *unloaded = nullptr;
+    size_t Bytes(const FakeResource& resource) const {
+        return resource.bytes;
+    }
+    void Unload(FakeResource& resource) {
+        unloaded->push_back(resource.version);
+    }
+};
+
+using FakeCache = AssetCache<FakeResource, FakeCacheBackend>;
+
+static AssetId Id(uint32_t index) {
+
+    return AssetId{index};
+
+}
+
+static bool WasUnloaded(const std::vector<int>& unloaded, int version) {
+
+    return std::find(unloaded.begin(), unloaded.end(), version) != unloaded.end();
+
+}
+
+TEST(AssetCacheEvictsLeastRecentlyUsed) {
+
+    std::vector<int> unloaded;
+    FakeCache cache(300, FakeCacheBackend{&unloaded});
+
+    cache.Insert(Id(0), {100, 0});
+    cache.Insert(Id(1), {100, 1});
+    cache.Insert(Id(2), {100, 2});
+    CHECK(cache.GetStats().residentBytes == 300);
+    CHECK(cache.GetStats().misses == 3);
+
+    //innerhalb des Budgets wird nichts verdrängt
+    CHECK(cache.Trim() == 0);
+
+    //0 wird benutzt, damit ist 1 der älteste Eintrag
+    CHECK(cache.Find(Id(0)) != nullptr);
+    CHECK(cache.GetStats().hits == 1);
+    //Peek() verändert die Reihenfolge nicht
+    CHECK(cache.Peek(Id(1)) != nullptr);
+    cache.Insert(Id(3), {100, 3});
+
+    CHECK(cache.Trim() == 1);
+    CHECK(unloaded == (std::vector<int>{1}));
+    CHECK(cache.Peek(Id(1)) == nullptr);
+    CHECK(cache.GetStats().residentBytes == 300);
+    CHECK(cache.GetStats().entries == 3);
+    CHECK(cache.GetStats().evictions == 1);
+
+    //ein kleineres Budget verdrängt so viele wie nötig, älteste zuerst
+    cache.SetBudget(100);
+    CHECK(cache.Trim() == 2);
+    CHECK(unloaded == (std::vector<int>{1, 2, 0}));
+    CHECK(cache.Peek(Id(3)) != nullptr);
+
+}
+
+TEST(AssetCachePinsAndHandlesProtectEntries) {
+
+    std::vector<int> unloaded;
+    FakeCache cache(0, FakeCacheBackend{&unloaded});
+
+    cache.Insert(Id(0), {100, 0});
+    cache.Insert(Id(1), {100, 1});
+    cache.Insert(Id(2), {100, 2});
+
+    cache.Pin(Id(0));
+    FakeCache::Handle handle = cache.Acquire(Id(1));
+    CHECK(handle.IsValid());
+
+    //nur der freie Eintrag geht, obwohl das Budget danach immer noch nicht passt
+    CHECK(cache.Trim() == 1);
+    CHECK(unloaded == (std::vector<int>{2}));
+    CHECK(cache.GetStats().residentBytes == 200);
+
+    //Kopien zählen mit: erst wenn alle weg sind, ist der Eintrag frei
+    {
+        FakeCache::Handle copy = handle;
+        handle.Reset();
+        CHECK(cache.Trim() == 0);
+        CHECK(copy.Get().version == 1);
+    }
+    CHECK(cache.Trim() == 1);
+    CHECK(WasUnloaded(unloaded, 1));
+
+    //Free() entlädt einen gepinnten Eintrag ohne Handles sofort
+    cache.Free(Id(0));
+    CHECK(WasUnloaded(unloaded, 0));
+    CHECK(cache.GetStats().entries == 0);
+    CHECK(cache.GetStats().residentBytes == 0);
+
+    //Acquire() auf einen fehlenden Eintrag gibt ein ungültiges Handle
+    CHECK(!cache.Acquire(Id(5)).IsValid());
+
+}
+
+TEST(AssetCacheReplaceKeepsHandles) {
+
+    std::vector<int> unloaded;
+    FakeCache cache(1000, FakeCacheBackend{&unloaded});
+
+    cache.Insert(Id(0), {100, 0});
+    FakeCache::Handle handle = cache.Acquire(Id(0));
+    cache.Pin(Id(0));
+
+    //wie ein Hot Reload: der alte Wert wird entladen, Handle und Pin bleiben am Eintrag
+    cache.Insert(Id(0), {250, 10});
+    CHECK(unloaded == (std::vector<int>{0}));
+    CHECK(handle.Get().version == 10);
+    CHECK(cache.GetStats().residentBytes == 250);
+    CHECK(cache.GetStats().entries == 1);
+    CHECK(cache.GetStats().misses == 1);
+
+    cache.SetBudget(0);
+    handle.Reset();
+    CHECK(cache.Trim() == 0);
+
+}
+
+TEST(AssetCacheHandleOutlivesCache) {
+
+    std::vector<int> unloaded;
+    FakeCache::Handle handle;
+
+    {
+        FakeCache cache(1000, FakeCacheBackend{&unloaded});
+        cache.Insert(Id(0), {100, 0});
+        handle = cache.Acquire(Id(0));
+    }
+
+    //der Cache hat beim Zerstören alles entladen, das Handle ist jetzt ungültig aber harmlos
+    CHECK(unloaded == (std::vector<int>{0}));
+    CHECK(!handle.IsValid());
+    CHECK(handle.Get().bytes == 0);
+    handle.Reset();
+
+}
@@ -0,0 +1,91 @@
+#include "test.h"
+
+#include "../src/io/debug.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size) {
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+
+}
+
+void operator delete(void *p) noexcept {
+
+    std::free(p);
+
+}
+
+void operator delete(void *p, size_t) noexcept {
+
+    std::free(p);
+
+}
+
+namespace Test {
+
+    static int failures = 0;
+
+    std::vector<Case>& Registry() {
+
+        static std::vector<Case> cases;
+        return cases;
+
+    }
+
+    void Fail(const char *file, int line, const char *expression) {
+
+        ++failures;
+        std::printf("    %s:%i: CHECK(%s) failed\n", file, line, expression);
+
+    }
+
+    uint64_t AllocationCount() {
+
+        return allocations.load(std::memory_order_relaxed);
+
+    }
+
+}
+
+/**
+ * Führt alle Tests und Benchmarks aus, oder nur die, deren Name das erste Argument enthält.
+ * Aufruf: swtest [Filter], z.B. swtest WorldFile
+ */
+int main(int argc, char **argv) {
+
+    const char *filter = argc > 1 ? argv[1] : "";
+    int failedCases = 0;
+
+    for (const Test::Case& testCase : Test::Registry()) {
+
+        if (std::strstr(testCase.name, filter) == nullptr) {
+            continue;
+        }
+
+        const int before = Test::failures;
+        testCase.run();
+        Debug::Flush();
+
+        const bool ok = Test::failures == before;
+        std::printf("[%s] %s\n", ok ? " ok " : "FAIL", testCase.name);
+        if (!ok) {
+            ++failedCases;
+        }
+
+    }
+
+    std::printf("%i failed\n", failedCases);
+    return failedCases == 0 ? 0 : 1;
+
+}
@@ -0,0 +1,176 @@
+#include "test.h"
+
+#include "../src/engine/mixer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//bei 1000 Hz sind Millisekunden gleich Frames
+static constexpr unsigned int RATE = 1000;
+
+/**
+ * Baut ein 16 Bit Stereo .wav im Speicher; sample(i) ergibt den Wert beider Kanäle von Frame i.
+ */
+template<typename Sample>
+static std::vector<unsigned char> MakeWav(size_t frames, Sample sample) {
+
+    const uint32_t dataBytes = static_cast<uint32_t>(frames * 4);
+    std::vector<unsigned char> wav(44 + dataBytes);
+    unsigned char *p = wav.data();
+
+    auto put = [&p](const void *data, size_t size) {
+        std::memcpy(p, data, size);
+        p += size;
+    };
+    auto put16 = [&put](uint16_t value) { put(&value, 2); };
+    auto put32 = [&put](uint32_t value) { put(&value, 4); };
+
+    put("RIFF", 4);
+    put32(36 + dataBytes);
+    put("WAVEfmt ", 8);
+    put32(16);
+    put16(1);
+    put16(2);
+    put32(RATE);
+    put32(RATE * 4);
+    put16(4);
+    put16(16);
+    put("data", 4);
+    put32(dataBytes);
+
+    for (size_t i = 0; i < frames; ++i) {
+        const int16_t value = sample(i);
+        put(&value, 2);
+        put(&value, 2);
+    }
+
+    return wav;
+
+}
+
+static std::shared_ptr<MusicStream> OpenStream(const std::vector<unsigned char>& wav) {
+
+    return std::make_shared<MusicStream>(WavStream::OpenMemory(wav, "test.wav"));
+
+}
+
+static bool Near(float a, float b) {
+
+    return std::fabs(a - b) < 1e-5f;
+
+}
+
+TEST(MixerFadeInRampPerSample) {
+
+    const std::vector<unsigned char> wav = MakeWav(200, [](size_t) { return int16_t{16384}; });
+    SoundQueue queue(RATE);
+    queue.QueueFadeIn(OpenStream(wav), 10);
+
+    std::vector<float> out(50 * AudioMixer::CHANNELS);
+    queue.GetMixer().Render(out.data(), 50);
+
+    //Frame i hat Lautstärke i / 10, danach voll
+    for (size_t i = 0; i < 50; ++i) {
+        const float expected = 0.5f * std::min(1.0f, i / 10.0f);
+        CHECK(Near(out[i * 2], expected));
+        CHECK(Near(out[i * 2 + 1], expected));
+    }
+    CHECK(queue.GetMixer().GetState() == SoundQueueState::PLAYING);
+
+    queue.Clear();
+    queue.GetMixer().Render(out.data(), 1);
+    queue.Update();
+    CHECK(queue.IsEmpty());
+
+}
+
+TEST(MixerCrossfadeStartsOnExactFrame) {
+
+    const std::vector<unsigned char> first = MakeWav(100, [](size_t) { return int16_t{8192}; });
+    const std::vector<unsigned char> second = MakeWav(200, [](size_t) { return int16_t{-16384}; });
+
+    SoundQueue queue(RATE);
+    queue.Queue(OpenStream(first));
+    queue.QueueCrossfade(OpenStream(second), 20);
+
+    //in ungeraden Blöcken rendern, damit Blockgrenzen nicht zufällig auf den Übergängen liegen
+    std::vector<float> out(150 * AudioMixer::CHANNELS);
+    for (size_t done = 0; done < 150;) {
+        const size_t block = std::min<size_t>(7, 150 - done);
+        queue.GetMixer().Render(out.data() + done * AudioMixer::CHANNELS, block);
+        done += block;
+    }
+
+    //100 Frames minus 20 Frames Blende: ab Frame 80 wird übergeblendet, Frame 99 ist der letzte des ersten Stücks
+    for (size_t i = 0; i < 150; ++i) {
+
+        float expected;
+        if (i < 80) {
+            expected = 0.25f;
+        } else if (i < 100) {
+            const float t = (i - 80) / 20.0f;
+            expected = 0.25f * (1 - t) - 0.5f * t;
+        } else {
+            expected = -0.5f;
+        }
+
+        CHECK(Near(out[i * 2], expected));
+
+    }
+
+    //das erste Stück ist zurückgemeldet, das zweite läuft noch
+    queue.Update();
+    CHECK(!queue.IsEmpty());
+    CHECK(queue.GetMixer().GetState() == SoundQueueState::PLAYING);
+
+}
+
+TEST(MixerDecoderStallKeepsTail) {
+
+    //ein Vielfaches des Ringpuffers: der Decoder füllt ihn nur alle 20ms, der erste große Block läuft ihm also sicher davon; kein Sample ist 0
+    constexpr size_t FRAMES = 200000;
+    const std::vector<unsigned char> wav = MakeWav(FRAMES, [](size_t i) { return static_cast<int16_t>(1 + i % 30000); });
+
+    SoundQueue queue(RATE);
+    queue.Queue(OpenStream(wav));
+
+    std::vector<float> out(FRAMES * AudioMixer::CHANNELS);
+    std::vector<int16_t> heard;
+    heard.reserve(FRAMES);
+    size_t silentFrames = 0;
+
+    for (int block = 0; block < 1000 && !queue.IsEmpty(); ++block) {
+
+        const size_t frames = block == 0 ? FRAMES : 4096;
+        queue.GetMixer().Render(out.data(), frames);
+
+        for (size_t i = 0; i < frames; ++i) {
+            const int16_t sample = static_cast<int16_t>(std::lround(out[i * 2] * 32768.0f));
+            if (sample == 0) {
+                ++silentFrames;
+            } else {
+                heard.push_back(sample);
+            }
+        }
+
+        queue.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    }
+
+    //Stille nur dort, wo der Decoder hing; dazwischen jeder Frame genau einmal und nichts vom Ende abgeschnitten
+    CHECK(queue.IsEmpty());
+    CHECK(heard.size() == FRAMES);
+    bool inOrder = heard.size() == FRAMES;
+    for (size_t i = 0; inOrder && i < FRAMES; ++i) {
+        inOrder = heard[i] == static_cast<int16_t>(1 + i % 30000);
+    }
+    CHECK(inOrder);
+    std::printf("    %zu silent frames while the decoder caught up\n", silentFrames);
+
+}
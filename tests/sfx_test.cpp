@@ -0,0 +1,150 @@
+#include "test.h"
+
+#include "../src/engine/sfx.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Backend ohne Audiogerät. Aliase werden über frameCount unterschieden; ein gestarteter Alias spielt length Schritte von now lang.
+ */
+class FakeSfxBackend final : public SfxBackend {
+    public:
+        uint64_t now = 1;
+        uint64_t length = 20;
+        uint64_t plays = 0;
+        uint64_t stops = 0;
+        virtual bool IsReady() override {
+            return true;
+        }
+        virtual Sound CreateAlias(Sound) override {
+            Sound alias{};
+            alias.frameCount = static_cast<unsigned int>(endsAt.size());
+            endsAt.push_back(0);
+            return alias;
+        }
+        virtual void DestroyAlias(Sound) override {}
+        virtual void Play(Sound sound) override {
+            endsAt[sound.frameCount] = now + length;
+            ++plays;
+        }
+        virtual void Stop(Sound sound) override {
+            endsAt[sound.frameCount] = 0;
+            ++stops;
+        }
+        virtual bool IsPlaying(Sound sound) override {
+            return endsAt[sound.frameCount] > now;
+        }
+        virtual void SetVolume(Sound, float) override {}
+        virtual void SetPitch(Sound, float) override {}
+        virtual void SetPan(Sound, float) override {}
+    private:
+        std::vector<uint64_t> endsAt;
+};
+
+static AssetId SoundId(uint32_t index) {
+
+    return AssetId{index + 1};
+
+}
+
+TEST(SfxPoolStealing) {
+
+    FakeSfxBackend backend;
+    SfxPool pool(nullptr, 4, &backend);
+    pool.Preload(SoundId(0), Sound{}, 4);
+    pool.Preload(SoundId(1), Sound{}, 4);
+    pool.Preload(SoundId(2), Sound{}, 1);
+
+    std::vector<SfxHandle> low;
+    for (int i = 0; i < 4; ++i) {
+        const std::optional<SfxHandle> handle = pool.Play(SoundId(0));
+        CHECK(handle.has_value());
+        if (handle.has_value()) {
+            low.push_back(handle.value());
+        }
+    }
+    CHECK(pool.GetActiveCount() == 4);
+
+    //alle Stimmen belegt: die wichtigere Anfrage stiehlt die älteste unwichtige Stimme
+    const std::optional<SfxHandle> important = pool.Play(SoundId(1), {.priority = 1});
+    CHECK(important.has_value());
+    CHECK(!pool.IsPlaying(low[0]));
+    CHECK(pool.IsPlaying(low[1]));
+    CHECK(pool.GetStats().steals == 1);
+
+    //eine unwichtigere Anfrage stiehlt nie
+    CHECK(!pool.Play(SoundId(1), {.priority = -1}).has_value());
+    CHECK(pool.GetStats().dropped == 1);
+
+    //ausgespielte Stimmen werden ohne Stehlen wiederverwendet
+    backend.now += backend.length;
+    CHECK(pool.GetActiveCount() == 0);
+
+    //ein Sound mit nur einem Alias startet seine eigene Instanz neu
+    const std::optional<SfxHandle> first = pool.Play(SoundId(2));
+    const std::optional<SfxHandle> second = pool.Play(SoundId(2));
+    CHECK(first.has_value() && second.has_value());
+    CHECK(first.has_value() && !pool.IsPlaying(first.value()));
+    CHECK(second.has_value() && pool.IsPlaying(second.value()));
+    CHECK(pool.GetActiveCount() == 1);
+
+    //nicht vorgeladene Sounds werden verworfen
+    CHECK(!pool.Play(SoundId(7)).has_value());
+
+}
+
+TEST(SfxPoolStressBenchmark) {
+
+    constexpr uint32_t SOUNDS = 16;
+    constexpr int TRIGGERS = 200000;
+    //so viele Trigger pro simuliertem Tick; bei 20 TPS sind das 4000 pro Sekunde
+    constexpr int TRIGGERS_PER_TICK = 200;
+
+    FakeSfxBackend backend;
+    backend.length = 3;
+    SfxPool pool(nullptr, SfxPool::DEFAULT_VOICES, &backend);
+    for (uint32_t i = 0; i < SOUNDS; ++i) {
+        pool.Preload(SoundId(i), Sound{}, SfxPool::DEFAULT_INSTANCES);
+    }
+
+    uint32_t random = 12345;
+    size_t maxActive = 0;
+
+    const uint64_t allocationsBefore = Test::AllocationCount();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < TRIGGERS; ++i) {
+
+        random = random * 1664525u + 1013904223u;
+        const SfxParams params{.volume = 0.5f, .pitch = 1.0f, .pan = 0.0f, .priority = static_cast<int>((random >> 24) % 4)};
+        const std::optional<SfxHandle> handle = pool.Play(SoundId((random >> 16) % SOUNDS), params);
+
+        if (handle.has_value() && (random & 7) == 0) {
+            pool.SetPan(handle.value(), -0.5f);
+        }
+
+        if ((i + 1) % TRIGGERS_PER_TICK == 0) {
+            ++backend.now;
+            const size_t active = pool.GetActiveCount();
+            maxActive = active > maxActive ? active : maxActive;
+        }
+
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint64_t allocations = Test::AllocationCount() - allocationsBefore;
+
+    const SfxStats& stats = pool.GetStats();
+    CHECK(allocations == 0);
+    CHECK(stats.triggers == TRIGGERS);
+    CHECK(stats.steals > 0);
+    CHECK(backend.plays == stats.triggers - stats.dropped);
+    CHECK(maxActive <= pool.GetVoiceCount());
+
+    std::printf("    %i triggers in %.1f ms (%.0f per second), %llu steals, %llu dropped, %llu allocations\n", TRIGGERS, seconds * 1000.0,
+        TRIGGERS / seconds, static_cast<unsigned long long>(stats.steals), static_cast<unsigned long long>(stats.dropped),
+        static_cast<unsigned long long>(allocations));
+
+}
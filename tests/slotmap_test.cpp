@@ -0,0 +1,96 @@
+#include "test.h"
+
+#include "../src/engine/slotmap.h"
+
+#include <string>
+
+TEST(SlotMapStaleHandleAfterReuse) {
+
+    SlotMap<std::string> map;
+    const SlotMap<std::string>::Handle first = map.Insert("first");
+    CHECK(map.Contains(first));
+    CHECK(*map.Get(first) == "first");
+
+    CHECK(map.Erase(first));
+    CHECK(!map.Erase(first));
+    CHECK(map.Get(first) == nullptr);
+
+    //der freie Slot wird wiederverwendet, aber mit neuer Generation
+    const SlotMap<std::string>::Handle second = map.Insert("second");
+    CHECK(second.index == first.index);
+    CHECK(second.generation != first.generation);
+    CHECK(!map.Contains(first));
+    CHECK(map.Get(first) == nullptr);
+    CHECK(*map.Get(second) == "second");
+
+    //default-konstruierte und erfundene Handles sind nie gültig
+    CHECK(map.Get(SlotMap<std::string>::Handle{}) == nullptr);
+    CHECK(map.Get({7, 0}) == nullptr);
+
+}
+
+TEST(SlotMapSwapRemoveKeepsHandlesConsistent) {
+
+    SlotMap<int> map;
+    SlotMap<int>::Handle handles[5];
+    for (int i = 0; i < 5; ++i) {
+        handles[i] = map.Insert(i * 10);
+    }
+
+    //aus der Mitte entfernen: das letzte Element rückt in die Lücke
+    CHECK(map.Erase(handles[1]));
+    CHECK(map.Size() == 4);
+    CHECK(map.Values()[1] == 40);
+
+    for (int i : {0, 2, 3, 4}) {
+        CHECK(map.Get(handles[i]) != nullptr && *map.Get(handles[i]) == i * 10);
+    }
+
+    //HandleAt() und Get() zeigen für jede dichte Position auf dasselbe Element
+    for (size_t dense = 0; dense < map.Size(); ++dense) {
+        const SlotMap<int>::Handle handle = map.HandleAt(dense);
+        CHECK(map.Get(handle) == &map.Values()[dense]);
+    }
+    CHECK(map.HandleAt(1) == handles[4]);
+
+    //das letzte Element entfernen verschiebt nichts
+    CHECK(map.Erase(handles[3]));
+    CHECK(map.Size() == 3);
+    CHECK(map.HandleAt(0) == handles[0] && map.HandleAt(1) == handles[4] && map.HandleAt(2) == handles[2]);
+
+    int sum = 0;
+    for (int value : map) {
+        sum += value;
+    }
+    CHECK(sum == 0 + 40 + 20);
+
+}
+
+TEST(SlotMapClearInvalidatesHandles) {
+
+    SlotMap<int> map;
+    SlotMap<int>::Handle handles[4];
+    for (int i = 0; i < 4; ++i) {
+        handles[i] = map.Insert(i);
+    }
+
+    map.Clear();
+    CHECK(map.Empty());
+    for (const SlotMap<int>::Handle handle : handles) {
+        CHECK(!map.Contains(handle));
+        CHECK(map.Get(handle) == nullptr);
+        CHECK(!map.Erase(handle));
+    }
+
+    //die Slots werden danach wiederverwendet, ohne dass alte Handles wieder gültig werden
+    for (int i = 0; i < 4; ++i) {
+        const SlotMap<int>::Handle handle = map.Insert(100 + i);
+        CHECK(handle.index < 4);
+        CHECK(*map.Get(handle) == 100 + i);
+    }
+    CHECK(map.Size() == 4);
+    for (const SlotMap<int>::Handle handle : handles) {
+        CHECK(map.Get(handle) == nullptr);
+    }
+
+}
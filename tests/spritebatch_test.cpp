@@ -0,0 +1,117 @@
+#include "test.h"
+
+#include "../src/engine/assets.h"
+#include "../src/engine/render.h"
+
+static Texture2D FakeTexture(unsigned int id) {
+
+    return Texture2D{id, 256, 256, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+
+}
+
+static void DrawAt(SpriteBatch& batch, unsigned int texture, int layer, float x) {
+
+    batch.Draw(FakeTexture(texture), {0, 0, 16, 16}, {x, 0, 16, 16}, WHITE, layer);
+
+}
+
+TEST(SpriteBatchSortsByLayerAndTexture) {
+
+    CountingSpriteBatchBackend backend;
+    SpriteBatch batch(&backend);
+
+    //absichtlich durcheinander eingereiht
+    DrawAt(batch, 2, 1, 0);
+    DrawAt(batch, 1, 0, 1);
+    DrawAt(batch, 3, 0, 2);
+    DrawAt(batch, 1, 1, 3);
+    DrawAt(batch, 1, 0, 4);
+    DrawAt(batch, 3, 0, 5);
+    batch.Draw(Texture2D{}, {0, 0, 1, 1}, {0, 0, 1, 1});
+    CHECK(batch.GetQueuedCount() == 6);
+
+    batch.Flush();
+
+    CHECK(batch.GetQueuedCount() == 0);
+    CHECK(batch.GetRunsLastFlush() == 4);
+    CHECK(backend.GetRunTextures() == (std::vector<unsigned int>{1, 3, 1, 2}));
+
+    //Layer aufsteigend, innerhalb von Layer und Textur in der Reihenfolge des Einreihens
+    const std::vector<SpriteQuad>& quads = backend.GetDrawnQuads();
+    CHECK(quads.size() == 6);
+    const float expectedX[] = {1, 4, 2, 5, 3, 0};
+    for (size_t i = 0; i < quads.size() && i < 6; ++i) {
+        CHECK(quads[i].dest.x == expectedX[i]);
+    }
+
+    //ein leerer Flush zeichnet nichts
+    backend.Reset();
+    batch.Flush();
+    CHECK(batch.GetRunsLastFlush() == 0);
+    CHECK(backend.GetRunCount() == 0);
+
+}
+
+TEST(SpriteBatchMergesRunsAcrossLayers) {
+
+    CountingSpriteBatchBackend backend;
+    SpriteBatch batch(&backend);
+
+    //die letzte Textur von Layer 0 ist die erste von Layer 1, beide Teile werden ein Lauf
+    DrawAt(batch, 1, 0, 0);
+    DrawAt(batch, 2, 0, 1);
+    DrawAt(batch, 2, 1, 2);
+    DrawAt(batch, 3, 1, 3);
+    batch.Flush();
+
+    CHECK(batch.GetRunsLastFlush() == 3);
+    CHECK(backend.GetRunTextures() == (std::vector<unsigned int>{1, 2, 3}));
+
+    //eine Textur über viele Layer hinweg bleibt ein einziger Draw Call
+    backend.Reset();
+    for (int layer = 0; layer < 8; ++layer) {
+        DrawAt(batch, 5, layer, static_cast<float>(layer));
+    }
+    batch.Flush();
+
+    CHECK(batch.GetRunsLastFlush() == 1);
+    CHECK(backend.GetDrawnQuads().size() == 8);
+    CHECK(backend.GetDrawnQuads().back().layer == 7);
+
+}
+
+TEST(SpriteBatchGlyphStringIsOneRun) {
+
+    CountingSpriteBatchBackend backend;
+    SpriteBatch batch(&backend);
+    FontRenderer font("swtest-no-font/", nullptr);
+    font.SetSpriteBatch(&batch);
+
+    //so setzt Layout() einen String, dessen Buchstaben alle auf einer Atlasseite liegen
+    const Texture2D page = FakeTexture(7);
+    TextLayout layout;
+    for (int i = 0; i < 26; ++i) {
+        const float x = static_cast<float>(i * 8);
+        layout.glyphs.push_back({page, {x, 0, 8, 12}, {x, 0, 8, 12}});
+    }
+
+    font.DrawLayout(layout, {10, 10});
+    font.DrawLayout(layout, {10, 30});
+    batch.Flush();
+
+    CHECK(batch.GetRunsLastFlush() == 1);
+    CHECK(backend.GetRunTextures() == (std::vector<unsigned int>{7}));
+    CHECK(backend.GetDrawnQuads().size() == 52);
+    CHECK(backend.GetDrawnQuads()[26].dest.y == 30);
+
+    //ein Buchstabe auf einer zweiten Seite kostet genau einen weiteren Lauf
+    backend.Reset();
+    layout.glyphs[13].texture = FakeTexture(8);
+    font.DrawLayout(layout, {10, 10});
+    batch.Flush();
+
+    CHECK(batch.GetRunsLastFlush() == 2);
+
+    font.SetSpriteBatch(nullptr);
+
+}
@@ -0,0 +1,102 @@
+#include "test.h"
+
+#include "../src/gameplay/world/streaming.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/**
+ * Quelle, deren LoadChunk() wartet, bis der Test sie freigibt. Solange bleiben alle weiteren Aufträge in der Queue des Streamers liegen.
+ */
+class GatedChunkSource final : public ChunkSource {
+    public:
+        virtual std::unique_ptr<Chunk> LoadChunk(ChunkPos pos) override {
+            std::unique_lock<std::mutex> lock(mutex);
+            loaded.push_back(pos);
+            changed.notify_all();
+            changed.wait(lock, [this] { return open; });
+            return nullptr;
+        }
+        virtual void SaveChunk(const Chunk& chunk) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            saved.push_back(chunk.pos);
+        }
+        void WaitForFirstLoad() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !loaded.empty(); });
+        }
+        void Open() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                open = true;
+            }
+            changed.notify_all();
+        }
+        std::vector<ChunkPos> GetLoaded() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return loaded;
+        }
+        std::vector<ChunkPos> GetSaved() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return saved;
+        }
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool open = false;
+        std::vector<ChunkPos> loaded;
+        std::vector<ChunkPos> saved;
+};
+
+TEST(ChunkStreamerDropsStaleLoadJobs) {
+
+    World world;
+    GatedChunkSource source;
+
+    {
+        //Radius 1 sind 9 Chunks, genau das Budget
+        ChunkStreamer streamer(&world, &source, 1, 9);
+
+        streamer.SetCenter({0, 0});
+        CHECK(streamer.GetPendingCount() == 9);
+
+        //der Worker hängt im ersten Auftrag, die übrigen 8 liegen noch in der Queue
+        source.WaitForFirstLoad();
+
+        //ein veränderter Chunk, der beim Umziehen entladen wird; sein Speicherauftrag landet hinter den alten Ladeaufträgen und darf nicht mit ihnen verschwinden
+        world.CreateChunk({1, 0})->modified = true;
+
+        //die Kamera springt weit weg: die alten Aufträge dürfen das Budget nicht mehr belegen
+        streamer.SetCenter({100, 0});
+        //der laufende Auftrag zählt noch mit, dazu 8 der 9 neuen
+        CHECK(streamer.GetPendingCount() == 9);
+
+        source.Open();
+        streamer.Flush();
+        streamer.InstallFinishedChunks();
+
+        //nur der schon laufende alte Auftrag wurde noch geladen, und dann verworfen
+        size_t staleLoads = 0;
+        for (const ChunkPos pos : source.GetLoaded()) {
+            if (pos.x < 50) {
+                ++staleLoads;
+            }
+        }
+        CHECK(staleLoads == 1);
+        CHECK(source.GetLoaded().size() == 9);
+        CHECK(world.GetChunkCount() == 8);
+        CHECK(world.GetChunk({100, 0}) != nullptr);
+        CHECK(world.GetChunk({0, 0}) == nullptr);
+        CHECK(streamer.GetPendingCount() == 0);
+
+        CHECK(source.GetSaved() == (std::vector<ChunkPos>{{1, 0}}));
+
+        //das Budget ist nicht mehr verstopft: beim nächsten Schritt kommen die neuen Chunks nach
+        streamer.SetCenter({101, 0});
+        streamer.Flush();
+        streamer.InstallFinishedChunks();
+        CHECK(world.GetChunk({102, 0}) != nullptr);
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Minimales Testgerüst für swtest. TEST() registriert eine Funktion, CHECK() meldet einen Fehler, ohne den Test abzubrechen.
+ * Tests laufen ohne Fenster und Audiogerät; was raylib braucht, geht über die Backend-Schnittstellen der Engine.
+ */
+namespace Test {
+
+    struct Case {
+        const char *name;
+        void (*run)();
+    };
+
+    std::vector<Case>& Registry();
+
+    void Fail(const char *file, int line, const char *expression);
+
+    /**
+     * Anzahl aller bisherigen operator new Aufrufe im Prozess. Die Differenz um einen Codeabschnitt zeigt, ob er alloziert.
+     */
+    uint64_t AllocationCount();
+
+    struct Registrar {
+        Registrar(const char *name, void (*run)()) {
+            Registry().push_back({name, run});
+        }
+    };
+
+}
+
+#define TEST(name) \
+    static void name(); \
+    static const Test::Registrar name##Registrar{#name, name}; \
+    static void name()
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            Test::Fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (false)
@@ -0,0 +1,156 @@
+#include "test.h"
+
+#include "../src/gameplay/world/tilerenderer.h"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Backend ohne GPU: vergibt fortlaufende Target-IDs und protokolliert, welche Chunks gebacken und welche Targets freigegeben wurden.
+ */
+class CountingChunkRenderBackend final : public ChunkRenderBackend {
+    public:
+        uint64_t generation = 0;
+        std::vector<ChunkPos> baked;
+        std::vector<unsigned int> released;
+        size_t draws = 0;
+        virtual RenderTexture2D CreateTarget() override {
+            RenderTexture2D target{};
+            target.id = ++nextId;
+            return target;
+        }
+        virtual void Bake(RenderTexture2D, const Chunk& chunk) override {
+            baked.push_back(chunk.pos);
+        }
+        virtual void Draw(RenderTexture2D, Rectangle) override {
+            ++draws;
+        }
+        virtual void Release(RenderTexture2D target) override {
+            released.push_back(target.id);
+        }
+        virtual uint64_t GetTextureGeneration() override {
+            return generation;
+        }
+    private:
+        unsigned int nextId = 0;
+};
+
+static bool WasBaked(const std::vector<ChunkPos>& baked, ChunkPos pos) {
+
+    return std::find(baked.begin(), baked.end(), pos) != baked.end();
+
+}
+
+//der Bereich der Chunks (x, y) bis (x + width - 1, y + height - 1) in Weltpixeln
+static Rectangle ChunkView(int x, int y, int width, int height) {
+
+    const float size = static_cast<float>(CHUNK_PIXEL_SIZE);
+    return {x * size, y * size, width * size, height * size};
+
+}
+
+TEST(TileRendererCullsToView) {
+
+    CHECK(ComputeVisibleChunks(ChunkView(0, 0, 2, 1)).maxX == 1);
+    //ein Pixel über die Kante hinaus reicht für den nächsten Chunk, auch ins Negative
+    const ChunkRange range = ComputeVisibleChunks({-1, 0, 2.0f * CHUNK_PIXEL_SIZE + 2, 1});
+    CHECK(range.minX == -1 && range.maxX == 2 && range.minY == 0 && range.maxY == 0);
+
+    World world;
+    for (ChunkPos pos : {ChunkPos{0, 0}, ChunkPos{1, 0}, ChunkPos{-1, 0}, ChunkPos{0, 1}, ChunkPos{5, 5}}) {
+        world.CreateChunk(pos);
+    }
+
+    CountingChunkRenderBackend backend;
+    TileRenderer renderer(&backend);
+
+    //(1, 1) liegt im Bereich, ist aber nicht geladen
+    renderer.Prepare(world, ChunkView(0, 0, 2, 2));
+    CHECK(renderer.GetBakesLastFrame() == 3);
+    CHECK(renderer.GetCachedChunkCount() == 3);
+    CHECK(WasBaked(backend.baked, {0, 0}) && WasBaked(backend.baked, {1, 0}) && WasBaked(backend.baked, {0, 1}));
+    CHECK(!WasBaked(backend.baked, {-1, 0}) && !WasBaked(backend.baked, {5, 5}));
+
+    renderer.Draw();
+    CHECK(renderer.GetDrawsLastFrame() == 3);
+    CHECK(backend.draws == 3);
+
+}
+
+TEST(TileRendererRebakesOnlyChangedChunks) {
+
+    World world;
+    world.CreateChunk({0, 0});
+    world.CreateChunk({1, 0});
+
+    CountingChunkRenderBackend backend;
+    TileRenderer renderer(&backend);
+    const Rectangle view = ChunkView(0, 0, 2, 1);
+
+    renderer.Prepare(world, view);
+    CHECK(renderer.GetBakesLastFrame() == 2);
+
+    //unverändert: nichts zu tun
+    renderer.Prepare(world, view);
+    CHECK(renderer.GetBakesLastFrame() == 0);
+
+    //ein Tile in Chunk (1, 0) ändert dessen Revision
+    CHECK(world.SetTile(CHUNK_SIZE + 3, 4, 1));
+    backend.baked.clear();
+    renderer.Prepare(world, view);
+    CHECK(renderer.GetBakesLastFrame() == 1);
+    CHECK(backend.baked == (std::vector<ChunkPos>{{1, 0}}));
+
+    //ein neu geladener Chunk an derselben Position ist ein anderer Chunk, auch mit gleicher Revision
+    world.RemoveChunk({0, 0});
+    world.CreateChunk({0, 0});
+    backend.baked.clear();
+    renderer.Prepare(world, view);
+    CHECK(backend.baked == (std::vector<ChunkPos>{{0, 0}}));
+
+    //neue Tiletexturen: alles neu backen, aber nur einmal
+    ++backend.generation;
+    renderer.Prepare(world, view);
+    CHECK(renderer.GetBakesLastFrame() == 2);
+    renderer.Prepare(world, view);
+    CHECK(renderer.GetBakesLastFrame() == 0);
+
+    //die Targets werden wiederverwendet, nicht neu angelegt
+    CHECK(backend.released.empty());
+    CHECK(renderer.GetCachedChunkCount() == 2);
+
+}
+
+TEST(TileRendererReleasesAfterGracePeriod) {
+
+    World world;
+    world.CreateChunk({0, 0});
+    world.CreateChunk({5, 5});
+
+    CountingChunkRenderBackend backend;
+    TileRenderer renderer(&backend);
+
+    renderer.Prepare(world, ChunkView(0, 0, 1, 1));
+    CHECK(renderer.GetCachedChunkCount() == 1);
+
+    //(0, 0) ist ab jetzt unsichtbar und bleibt genau CACHE_GRACE_FRAMES Frames im Cache
+    for (unsigned int i = 0; i < TileRenderer::CACHE_GRACE_FRAMES; ++i) {
+        renderer.Prepare(world, ChunkView(5, 5, 1, 1));
+    }
+    CHECK(renderer.GetCachedChunkCount() == 2);
+    CHECK(backend.released.empty());
+
+    renderer.Prepare(world, ChunkView(5, 5, 1, 1));
+    CHECK(renderer.GetCachedChunkCount() == 1);
+    CHECK(backend.released == (std::vector<unsigned int>{1}));
+
+    //zurückscrollen backt neu in ein neues Target
+    renderer.Prepare(world, ChunkView(0, 0, 1, 1));
+    CHECK(renderer.GetBakesLastFrame() == 1);
+
+    //Clear() und der Destruktor geben alles frei
+    renderer.Clear();
+    CHECK(renderer.GetCachedChunkCount() == 0);
+    CHECK(backend.released.size() == 3);
+
+}
@@ -0,0 +1,100 @@
+#include "test.h"
+
+#include "../src/engine/timer.h"
+
+#include <cmath>
+
+static constexpr long long MILLIS = 1'000'000;
+
+TEST(FixedTimestepCountsTicks) {
+
+    ManualClock clock(5 * MILLIS);
+    //50ms pro Tick
+    FixedTimestep timestep(20, 5, &clock);
+
+    CHECK(timestep.BeginFrame() == 0);
+
+    clock.Advance(150 * MILLIS);
+    CHECK(timestep.BeginFrame() == 3);
+    CHECK(timestep.GetAlpha() == 0.0f);
+
+    //ein halber Tick bleibt im Akkumulator liegen ...
+    clock.Advance(25 * MILLIS);
+    CHECK(timestep.BeginFrame() == 0);
+    CHECK(std::fabs(timestep.GetAlpha() - 0.5f) < 1e-6f);
+
+    //... und wird mit der nächsten Hälfte zu einem ganzen Tick
+    clock.Advance(25 * MILLIS);
+    CHECK(timestep.BeginFrame() == 1);
+    CHECK(timestep.GetAlpha() == 0.0f);
+
+    //viele kleine Frames ergeben zusammen genau so viele Ticks wie ein großer
+    int ticks = 0;
+    for (int i = 0; i < 100; ++i) {
+        clock.Advance(7 * MILLIS);
+        ticks += timestep.BeginFrame();
+    }
+    CHECK(ticks == 14);
+    CHECK(std::fabs(timestep.GetAlpha() - 0.0f) < 1e-6f);
+
+}
+
+TEST(FixedTimestepClampsCatchUp) {
+
+    ManualClock clock;
+    FixedTimestep timestep(20, 5, &clock);
+
+    //eine Sekunde Hänger wären 20 Ticks, nachgeholt werden nur 5 und der Rest verfällt
+    clock.Advance(1000 * MILLIS + 30 * MILLIS);
+    CHECK(timestep.BeginFrame() == 5);
+    CHECK(timestep.GetAlpha() == 0.0f);
+
+    //danach läuft die Simulation normal weiter
+    clock.Advance(50 * MILLIS);
+    CHECK(timestep.BeginFrame() == 1);
+
+    //genau an der Grenze wird noch nichts verworfen
+    clock.Advance(250 * MILLIS);
+    CHECK(timestep.BeginFrame() == 5);
+
+    //Reset() verwirft die Pause, z.B. nach dem Laden einer Welt
+    clock.Advance(10'000 * MILLIS);
+    timestep.Reset();
+    CHECK(timestep.BeginFrame() == 0);
+
+}
+
+TEST(TickTimerFractionalRateDoesNotDrift) {
+
+    //59.94 Ticks pro Sekunde (NTSC): eine Tickdauer von 16.6833...ms, die sich nicht in ganzen Millisekunden oder Nanosekunden darstellen lässt
+    ManualClock clock(123 * MILLIS);
+    TickTimer timer(59.94, &clock);
+    CHECK(timer.GetClock() == &clock);
+
+    //eine Stunde und 7ms in 1ms-Schritten; jeder Schritt ist kürzer als ein Tick, ShouldTick() liefert also höchstens einen pro Schritt
+    constexpr long long STEPS = 3'600'007;
+    long long ticks = 0;
+    for (long long i = 0; i < STEPS; ++i) {
+        clock.Advance(MILLIS);
+        if (timer.ShouldTick()) {
+            ++ticks;
+        }
+    }
+
+    //exakt in Ganzzahlen: Nanosekunden * 59.94 / 10^9
+    const long long elapsed = STEPS * MILLIS;
+    const long long expected = elapsed * 5994 / 100'000'000'000LL;
+    CHECK(ticks == expected);
+    CHECK(expected == 215784);
+
+    //der angebrochene Tick ist der exakte Rest, nicht ein über die Stunde aufgelaufener Fehler
+    const double exactPartial = static_cast<double>(elapsed) * 59.94 / 1e9 - static_cast<double>(expected);
+    CHECK(std::fabs(timer.GetPartialTick() - exactPartial) < 1e-3);
+    CHECK(timer.GetElapsedTicks() == 0);
+
+    //Reset() beginnt wieder bei 0
+    timer.Reset();
+    CHECK(timer.GetElapsedNanos() == 0);
+    CHECK(!timer.ShouldTick());
+
+}
@@ -0,0 +1,196 @@
+#include "test.h"
+
+#include "../src/gameplay/world/worldfile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+static std::string TempWorldPath() {
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "swtest_world.sww";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".tmp");
+    return path.string();
+
+}
+
+/**
+ * Füllt einen Chunk abhängig von seiner Position: gerade Chunks großflächig (RLE), ungerade mit Rauschen (roh gespeichert).
+ */
+static std::unique_ptr<Chunk> MakeChunk(ChunkPos pos, uint32_t seed) {
+
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
+    std::mt19937 random(seed ^ static_cast<uint32_t>(pos.x) * 73856093u ^ static_cast<uint32_t>(pos.y) * 19349663u);
+
+    for (size_t i = 0; i < CHUNK_AREA; ++i) {
+        if ((pos.x + pos.y) % 2 == 0) {
+            chunk->foreground[i] = static_cast<TileID>(i / CHUNK_SIZE < CHUNK_SIZE / 2 ? 0 : 1 + seed % 3);
+            chunk->background[i] = static_cast<TileID>(seed % 5);
+        } else {
+            chunk->foreground[i] = static_cast<TileID>(random() % 250);
+            chunk->background[i] = static_cast<TileID>(random() % 250);
+        }
+    }
+
+    return chunk;
+
+}
+
+static bool SameTiles(const Chunk& a, const Chunk& b) {
+
+    return a.foreground == b.foreground && a.background == b.background;
+
+}
+
+TEST(WorldFileRleRoundTrip) {
+
+    std::mt19937 random(7);
+
+    for (size_t size : {size_t{0}, size_t{1}, size_t{255}, size_t{256}, size_t{1000}, size_t{4096}}) {
+
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            //lange Läufe über die 255er Grenze hinweg, dazwischen Rauschen
+            data[i] = (i / 300) % 2 == 0 ? 42 : static_cast<unsigned char>(random());
+        }
+
+        const std::vector<unsigned char> encoded = RleEncode(data.data(), data.size());
+        std::vector<unsigned char> decoded(size);
+        CHECK(RleDecode(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+        CHECK(decoded == data);
+
+    }
+
+    //kaputte Eingaben werden abgelehnt statt über den Puffer hinaus geschrieben
+    unsigned char out[4];
+    const unsigned char tooLong[] = {5, 1};
+    const unsigned char zeroRun[] = {0, 1, 4, 1};
+    const unsigned char odd[] = {4};
+    const unsigned char tooShort[] = {3, 1};
+    CHECK(!RleDecode(tooLong, sizeof(tooLong), out, sizeof(out)));
+    CHECK(!RleDecode(zeroRun, sizeof(zeroRun), out, sizeof(out)));
+    CHECK(!RleDecode(odd, sizeof(odd), out, sizeof(out)));
+    CHECK(!RleDecode(tooShort, sizeof(tooShort), out, sizeof(out)));
+
+}
+
+TEST(WorldFileSaveGrowReload) {
+
+    const std::string path = TempWorldPath();
+    //mehr als die anfängliche Indexkapazität von 256, der Index wächst also zweimal
+    constexpr int SIDE = 24;
+
+    {
+        std::unique_ptr<WorldFile> file(WorldFile::Open(path));
+        CHECK(file != nullptr);
+        if (file == nullptr) {
+            return;
+        }
+
+        for (int y = 0; y < SIDE; ++y) {
+            for (int x = 0; x < SIDE; ++x) {
+                file->SaveChunk(*MakeChunk({x - SIDE / 2, y - SIDE / 2}, 1));
+            }
+        }
+        CHECK(file->GetChunkCount() == SIDE * SIDE);
+        CHECK(!std::filesystem::exists(path + ".tmp"));
+
+        //ein RLE-Chunk wird zu Rauschen und passt nicht mehr in seinen alten Platz, ein Rausch-Chunk schrumpft
+        std::unique_ptr<Chunk> grown = MakeChunk({1, 0}, 2);
+        grown->pos = {0, 0};
+        file->SaveChunk(*grown);
+        std::unique_ptr<Chunk> shrunk = MakeChunk({0, 0}, 3);
+        shrunk->pos = {1, 0};
+        file->SaveChunk(*shrunk);
+
+        std::unique_ptr<Chunk> loaded = file->LoadChunk({0, 0});
+        CHECK(loaded != nullptr && SameTiles(*loaded, *grown));
+        CHECK(file->LoadChunk({SIDE, SIDE}) == nullptr);
+    }
+
+    for (bool readOnly : {false, true}) {
+
+        std::unique_ptr<WorldFile> file(readOnly ? WorldFile::OpenReadOnly(path) : WorldFile::Open(path));
+        CHECK(file != nullptr);
+        if (file == nullptr) {
+            continue;
+        }
+
+        CHECK(file->GetChunkCount() == SIDE * SIDE);
+
+        for (int y = 0; y < SIDE; ++y) {
+            for (int x = 0; x < SIDE; ++x) {
+
+                const ChunkPos pos{x - SIDE / 2, y - SIDE / 2};
+                std::unique_ptr<Chunk> expected = MakeChunk(pos, 1);
+                if (pos == ChunkPos{0, 0}) {
+                    expected = MakeChunk({1, 0}, 2);
+                } else if (pos == ChunkPos{1, 0}) {
+                    expected = MakeChunk({0, 0}, 3);
+                }
+
+                std::unique_ptr<Chunk> loaded = file->LoadChunk(pos);
+                CHECK(loaded != nullptr && SameTiles(*loaded, *expected));
+
+            }
+        }
+
+    }
+
+    std::filesystem::remove(path);
+
+}
+
+TEST(WorldFileThroughput) {
+
+    const std::string path = TempWorldPath();
+    constexpr int COUNT = 1024;
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    chunks.reserve(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        chunks.push_back(MakeChunk({i % 32, i / 32}, 1));
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<WorldFile> file(WorldFile::Open(path));
+    CHECK(file != nullptr);
+    if (file == nullptr) {
+        return;
+    }
+
+    const Clock::time_point saveStart = Clock::now();
+    for (const std::unique_ptr<Chunk>& chunk : chunks) {
+        file->SaveChunk(*chunk);
+    }
+    const double saveSeconds = std::chrono::duration<double>(Clock::now() - saveStart).count();
+
+    file.reset(WorldFile::OpenReadOnly(path));
+    CHECK(file != nullptr);
+    if (file == nullptr) {
+        return;
+    }
+
+    size_t loaded = 0;
+    const Clock::time_point loadStart = Clock::now();
+    for (const std::unique_ptr<Chunk>& chunk : chunks) {
+        if (file->LoadChunk(chunk->pos) != nullptr) {
+            ++loaded;
+        }
+    }
+    const double loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+    CHECK(loaded == COUNT);
+
+    const double megabytes = COUNT * 2.0 * CHUNK_AREA / (1024.0 * 1024.0);
+    std::printf("    %i chunks, %.1f MB of tiles, file %.1f MB: save %.1f MB/s, load %.1f MB/s\n", COUNT, megabytes,
+        std::filesystem::file_size(path) / (1024.0 * 1024.0), megabytes / saveSeconds, megabytes / loadSeconds);
+
+    file.reset();
+    std::filesystem::remove(path);
+
+}
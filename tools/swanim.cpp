@@ -0,0 +1,73 @@
+#include "../src/engine/animfile.h"
+#include "../src/io/debug.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+/**
+ * Kompiliert eine .ani Datei (Text, base64-Frames) in das Binärformat .anib mit einem fertig gepackten Atlas.
+ * Aufruf: swanim <eingabe.ani> <ausgabe.anib> [png|rgba], z.B. swanim assets/void.ani assets/void.anib
+ * png (Standard) ist auf der Platte kleiner, rgba lädt ohne Dekodierung.
+ */
+int main(int argc, char **argv) {
+
+    if (argc != 3 && argc != 4) {
+
+        Debug::Log<Debug::LogLevel::ERROR>("Usage: %s <input .ani> <output .anib> [png|rgba]", argv[0]);
+        Debug::Flush();
+        return 1;
+
+    }
+
+    AnimationAtlasEncoding encoding = AnimationAtlasEncoding::PNG;
+    if (argc == 4) {
+
+        if (std::strcmp(argv[3], "rgba") == 0) {
+            encoding = AnimationAtlasEncoding::RGBA8;
+        } else if (std::strcmp(argv[3], "png") != 0) {
+            Debug::Log<Debug::LogLevel::ERROR>("Unknown atlas encoding '%s', expected png or rgba.", argv[3]);
+            Debug::Flush();
+            return 1;
+        }
+
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in.is_open()) {
+
+        Debug::Log<Debug::LogLevel::ERROR>("Could not open %s.", argv[1]);
+        Debug::Flush();
+        return 1;
+
+    }
+
+    std::ostringstream source;
+    source << in.rdbuf();
+
+    std::optional<AnimationData> data = ParseAnimationText(source.str());
+    if (!data.has_value()) {
+
+        Debug::Flush();
+        return 1;
+
+    }
+
+    const std::vector<unsigned char> bytes = WriteAnimationBinary(data.value(), encoding);
+    UnloadAnimationData(data.value());
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (bytes.empty() || !out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+
+        Debug::Log<Debug::LogLevel::ERROR>("Could not write %s.", argv[2]);
+        Debug::Flush();
+        return 1;
+
+    }
+
+    Debug::Log("Wrote %s (%zu bytes, %zu frames).", argv[2], bytes.size(), data->frames.size());
+    Debug::Flush();
+
+    return 0;
+
+}
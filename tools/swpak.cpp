@@ -0,0 +1,23 @@
+#include "../src/engine/archive.h"
+#include "../src/io/debug.h"
+
+/**
+ * Packt einen Asset-Ordner in ein .swpak Archiv.
+ * Aufruf: swpak <Ordner> <Ausgabedatei>, z.B. swpak assets/ assets.swpak
+ */
+int main(int argc, char **argv) {
+
+    if (argc != 3) {
+
+        Debug::Log<Debug::LogLevel::ERROR>("Usage: %s <asset directory> <output .swpak>", argv[0]);
+        Debug::Flush();
+        return 1;
+
+    }
+
+    const bool ok = WriteAssetArchive(argv[1], argv[2]);
+    Debug::Flush();
+
+    return ok ? 0 : 1;
+
+}